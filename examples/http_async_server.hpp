@@ -8,19 +8,25 @@
 #ifndef BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
+#include "response_cache.hpp"
 
 #include <beast/http.hpp>
+#include <beast/http/file_body.hpp>
+#include <beast/http/mmap_body.hpp>
 #include <beast/core/placeholders.hpp>
+#include <beast/core/slab_allocator.hpp>
 #include <beast/core/streambuf.hpp>
 #include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 namespace beast {
@@ -32,8 +38,6 @@ class http_async_server
     using address_type = boost::asio::ip::address;
     using socket_type = boost::asio::ip::tcp::socket;
 
-    using req_type = request_v1<string_body>;
-    using resp_type = response_v1<file_body>;
 
     std::mutex m_;
     bool log_ = true;
@@ -41,14 +45,35 @@ class http_async_server
     boost::asio::ip::tcp::acceptor acceptor_;
     socket_type sock_;
     std::string root_;
+    bool mmap_;
+    bool cached_;
+    bool slab_;
+    response_cache cache_;
     std::vector<std::thread> thread_;
 
 public:
+    /** Construct the server.
+
+        If `mmap` is `true`, files are sent from memory mappings
+        kept in the process-wide cache, instead of being read.
+
+        If `cached` is `true`, responses to HTTP/1.1 requests are
+        sent from a @ref response_cache, without serializing them.
+
+        If `slab` is `true`, each connection allocates its stream
+        buffer and message headers with @ref slab_allocator.
+    */
     http_async_server(endpoint_type const& ep,
-            std::size_t threads, std::string const& root)
+            std::size_t threads, std::string const& root,
+                bool mmap = false, bool cached = false,
+                    bool slab = false)
         : acceptor_(ios_)
         , sock_(ios_)
         , root_(root)
+        , mmap_(mmap)
+        , cached_(cached)
+        , slab_(slab)
+        , cache_("http_async_server")
     {
         acceptor_.open(ep.protocol());
         acceptor_.bind(ep);
@@ -72,6 +97,12 @@ public:
             t.join();
     }
 
+    endpoint_type
+    local_endpoint() const
+    {
+        return acceptor_.local_endpoint();
+    }
+
     template<class... Args>
     void
     log(Args const&... args)
@@ -183,18 +214,127 @@ private:
                 handler), stream, std::move(msg)};
     }
 
-    class peer : public std::enable_shared_from_this<peer>
+    // Storage for the state of the pending operations of one
+    // connection. Operations on a connection follow each other,
+    // so the same few blocks are reused for every request and
+    // response on a keep-alive connection. A completing operation
+    // may still hold its block while the next one starts on
+    // another thread, so blocks are claimed atomically.
+    class handler_memory
+    {
+        static std::size_t constexpr slot_size = 1024;
+        static std::size_t constexpr slots = 8;
+
+        typename std::aligned_storage<slot_size>::type slot_[slots];
+        std::atomic<bool> used_[slots];
+
+    public:
+        handler_memory()
+        {
+            for(auto& used : used_)
+                used = false;
+        }
+
+        handler_memory(handler_memory const&) = delete;
+        handler_memory& operator=(handler_memory const&) = delete;
+
+        void*
+        allocate(std::size_t size)
+        {
+            if(size <= slot_size)
+                for(std::size_t i = 0; i < slots; ++i)
+                    if(! used_[i].exchange(true,
+                            std::memory_order_acquire))
+                        return &slot_[i];
+            return ::operator new(size);
+        }
+
+        void
+        deallocate(void* p)
+        {
+            for(std::size_t i = 0; i < slots; ++i)
+                if(p == &slot_[i])
+                {
+                    used_[i].store(false,
+                        std::memory_order_release);
+                    return;
+                }
+            ::operator delete(p);
+        }
+    };
+
+    // Wraps a handler so that its operations use the handler_memory
+    template<class Handler>
+    class memory_handler
+    {
+        handler_memory& mem_;
+        Handler h_;
+
+    public:
+        memory_handler(handler_memory& mem, Handler&& h)
+            : mem_(mem)
+            , h_(std::move(h))
+        {
+        }
+
+        template<class... Args>
+        void
+        operator()(Args&&... args)
+        {
+            h_(std::forward<Args>(args)...);
+        }
+
+        friend
+        void*
+        asio_handler_allocate(
+            std::size_t size, memory_handler* h)
+        {
+            return h->mem_.allocate(size);
+        }
+
+        friend
+        void
+        asio_handler_deallocate(
+            void* p, std::size_t, memory_handler* h)
+        {
+            h->mem_.deallocate(p);
+        }
+
+        template<class Function>
+        friend
+        void
+        asio_handler_invoke(Function&& f, memory_handler* h)
+        {
+            boost_asio_handler_invoke_helpers::
+                invoke(f, h->h_);
+        }
+    };
+
+    template<class Handler>
+    static
+    memory_handler<typename std::decay<Handler>::type>
+    make_memory_handler(handler_memory& mem, Handler&& h)
+    {
+        return {mem, std::forward<Handler>(h)};
+    }
+
+    template<class Allocator>
+    class peer : public std::enable_shared_from_this<peer<Allocator>>
     {
+        using headers_type = basic_headers<Allocator>;
+
+        template<class Body>
+        using response_type = response_v1<Body, headers_type>;
+
         int id_;
-        streambuf sb_;
+        basic_streambuf<Allocator> sb_;
         socket_type sock_;
         http_async_server& server_;
         boost::asio::io_service::strand strand_;
-        req_type req_;
+        request_v1<string_body, headers_type> req_;
+        handler_memory mem_;
 
     public:
-        peer(peer&&) = default;
-        peer(peer const&) = default;
         peer& operator=(peer&&) = delete;
         peer& operator=(peer const&) = delete;
 
@@ -210,7 +350,8 @@ private:
         void
         fail(error_code ec, std::string what)
         {
-            if(ec != boost::asio::error::operation_aborted)
+            if(ec != boost::asio::error::operation_aborted &&
+                    ec != boost::asio::error::eof)
                 server_.log("#", id_, " ", what, ": ", ec.message(), "\n");
         }
 
@@ -219,11 +360,19 @@ private:
             do_read();
         }
 
+        template<class Handler>
+        memory_handler<typename std::decay<Handler>::type>
+        wrap(Handler&& h)
+        {
+            return make_memory_handler(mem_, std::forward<Handler>(h));
+        }
+
         void do_read()
         {
             async_read(sock_, sb_, req_, strand_.wrap(
-                std::bind(&peer::on_read, shared_from_this(),
-                    asio::placeholders::error)));
+                wrap(std::bind(&peer::on_read,
+                    this->shared_from_this(),
+                        asio::placeholders::error))));
         }
 
         void on_read(error_code const& ec)
@@ -236,7 +385,7 @@ private:
             path = server_.root_ + path;
             if(! boost::filesystem::exists(path))
             {
-                response_v1<string_body> res;
+                response_type<string_body> res;
                 res.status = 404;
                 res.reason = "Not Found";
                 res.version = req_.version;
@@ -245,27 +394,39 @@ private:
                 res.body = "The file '" + path + "' was not found";
                 prepare(res);
                 async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                    wrap(std::bind(&peer::on_write,
+                        this->shared_from_this(),
+                            asio::placeholders::error)));
                 return;
             }
+            if(server_.cached_ && req_.version == 11)
+            {
+                error_code ec;
+                auto const e = server_.cache_.get(path, ec);
+                if(! ec)
+                    return send_cached(e);
+            }
             try
             {
-                resp_type res;
-                res.status = 200;
-                res.reason = "OK";
-                res.version = req_.version;
-                res.headers.insert("Server", "http_async_server");
-                res.headers.insert("Content-Type", mime_type(path));
-                res.body = path;
-                prepare(res);
-                async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                if(server_.mmap_)
+                {
+                    error_code ec;
+                    response_type<mmap_body> res;
+                    res.body = mmap_body::cache::instance().get(path, ec);
+                    if(ec)
+                        throw system_error{ec};
+                    send_file(std::move(res), path);
+                }
+                else
+                {
+                    response_type<file_body> res;
+                    res.body = path;
+                    send_file(std::move(res), path);
+                }
             }
             catch(std::exception const& e)
             {
-                response_v1<string_body> res;
+                response_type<string_body> res;
                 res.status = 500;
                 res.reason = "Internal Error";
                 res.version = req_.version;
@@ -275,11 +436,52 @@ private:
                     std::string{"An internal error occurred"} + e.what();
                 prepare(res);
                 async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                    wrap(std::bind(&peer::on_write,
+                        this->shared_from_this(),
+                            asio::placeholders::error)));
             }
         }
 
+        template<class Body>
+        void
+        send_file(response_type<Body>&& res, std::string const& path)
+        {
+            res.status = 200;
+            res.reason = "OK";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Type", mime_type(path));
+            prepare(res);
+            async_write(sock_, std::move(res),
+                wrap(std::bind(&peer::on_write,
+                    this->shared_from_this(),
+                        asio::placeholders::error)));
+        }
+
+        void
+        send_cached(std::shared_ptr<response_cache::entry const> const& e)
+        {
+            // The entry is bound to the handler to keep
+            // its buffers alive until the write completes.
+            if(e->matches(req_))
+                boost::asio::async_write(sock_, e->not_modified(),
+                    wrap(std::bind(&peer::on_write_cached,
+                        this->shared_from_this(),
+                        e, asio::placeholders::error)));
+            else
+                boost::asio::async_write(sock_, e->buffers(),
+                    wrap(std::bind(&peer::on_write_cached,
+                        this->shared_from_this(),
+                        e, asio::placeholders::error)));
+        }
+
+        void on_write_cached(
+            std::shared_ptr<response_cache::entry const> const&,
+                error_code ec)
+        {
+            on_write(ec);
+        }
+
         void on_write(error_code ec)
         {
             if(ec)
@@ -315,10 +517,17 @@ private:
         if(ec)
             return fail(ec, "accept");
         socket_type sock(std::move(sock_));
+        // Send responses without waiting on acknowledgements
+        sock.set_option(boost::asio::ip::tcp::no_delay{true}, ec);
         acceptor_.async_accept(sock_,
             std::bind(&http_async_server::on_accept, this,
                 asio::placeholders::error));
-        std::make_shared<peer>(std::move(sock), *this)->run();
+        if(slab_)
+            std::make_shared<peer<slab_allocator<char>>>(
+                std::move(sock), *this)->run();
+        else
+            std::make_shared<peer<std::allocator<char>>>(
+                std::move(sock), *this)->run();
     }
 };
 
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using socket_type = boost::asio::ip::tcp::socket;
+using endpoint_type = boost::asio::ip::tcp::endpoint;
+
+// Forwards writes to a socket, hiding the socket type
+// so that file_body reads the file into its buffer.
+class copying_stream
+{
+    socket_type& sock_;
+
+public:
+    explicit
+    copying_stream(socket_type& sock)
+        : sock_(sock)
+    {
+    }
+
+    boost::asio::io_service&
+    get_io_service()
+    {
+        return sock_.get_io_service();
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers)
+    {
+        return sock_.write_some(buffers);
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers,
+        beast::error_code& ec)
+    {
+        return sock_.write_some(buffers, ec);
+    }
+};
+
+// Sends the file `repeat` times over a loopback connection
+template<class Send>
+void
+timed_test(std::string const& name, std::size_t repeat,
+    std::uint64_t size, boost::asio::io_service& ios,
+        boost::asio::ip::tcp::acceptor& acceptor, Send&& send)
+{
+    using clock_type = std::chrono::high_resolution_clock;
+    socket_type client(ios);
+    socket_type server(ios);
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+    std::uint64_t received = 0;
+    std::thread t{
+        [&]
+        {
+            static std::size_t constexpr N = 65536;
+            std::unique_ptr<char[]> buf(new char[N]);
+            beast::error_code ec;
+            while(! ec)
+                received += client.read_some(
+                    boost::asio::buffer(buf.get(), N), ec);
+        }};
+    auto const t0 = clock_type::now();
+    for(std::size_t i = 0; i < repeat; ++i)
+        send(server);
+    server.shutdown(socket_type::shutdown_send);
+    t.join();
+    auto const elapsed = std::chrono::duration_cast<
+        std::chrono::microseconds>(clock_type::now() - t0).count();
+    std::cout <<
+        name << ": " <<
+        (received / (1024 * 1024)) << "MB in " <<
+        (elapsed / 1000) << "ms, " <<
+        ((repeat * size) / (elapsed > 0 ? elapsed : 1)) << "MB/s" <<
+        std::endl;
+}
+
+int main(int ac, char const* av[])
+{
+    using namespace beast::http;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+
+    desc.add_options()
+        ("size,s",      po::value<std::uint64_t>()->implicit_value(64),
+                        "Set the size of the file in megabytes")
+        ("repeat,n",    po::value<std::size_t>()->implicit_value(16),
+                        "Set the number of times the file is sent")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    std::uint64_t size = 64;
+    if(vm.count("size"))
+        size = vm["size"].as<std::uint64_t>();
+    size *= 1024 * 1024;
+
+    std::size_t repeat = 16;
+    if(vm.count("repeat"))
+        repeat = vm["repeat"].as<std::size_t>();
+
+    auto const path = (boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path()).string();
+    {
+        std::ofstream os(path, std::ios::binary);
+        std::string const block(65536, '*');
+        for(std::uint64_t n = 0; n < size; n += block.size())
+            os.write(block.data(), block.size());
+    }
+    size = boost::filesystem::file_size(path);
+
+    boost::asio::io_service ios;
+    boost::asio::ip::tcp::acceptor acceptor(ios, endpoint_type{
+        boost::asio::ip::address_v4::loopback(), 0});
+
+    response_v1<file_body> res;
+    res.status = 200;
+    res.reason = "OK";
+    res.version = 11;
+    res.headers.insert("Server", "http_file_bench");
+    res.body = path;
+    prepare(res);
+
+    timed_test("file_body, read and write", repeat, size, ios, acceptor,
+        [&](socket_type& sock)
+        {
+            copying_stream stream(sock);
+            write(stream, res);
+        });
+
+    timed_test("file_body, sendfile", repeat, size, ios, acceptor,
+        [&](socket_type& sock)
+        {
+            write(sock, res);
+        });
+
+    timed_test("file_body, async sendfile",
+        repeat, size, ios, acceptor,
+        [&](socket_type& sock)
+        {
+            async_write(sock, res,
+                [](beast::error_code const& ec)
+                {
+                    if(ec)
+                        throw beast::system_error{ec};
+                });
+            ios.run();
+            ios.reset();
+        });
+
+    boost::filesystem::remove(path);
+}
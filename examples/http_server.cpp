@@ -29,6 +29,8 @@ int main(int ac, char const* av[])
         ("threads,n",   po::value<std::size_t>()->implicit_value(4),
                         "Set the number of threads to use")
         ("sync,s",      "Launch a synchronous server")
+        ("mmap,m",      "Send files from cached memory mappings")
+        ("cache,c",     "Send responses from a cache of serialized responses")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(ac, av, desc), vm);
@@ -51,6 +53,10 @@ int main(int ac, char const* av[])
 
     bool sync = vm.count("sync") > 0;
 
+    bool mmap = vm.count("mmap") > 0;
+
+    bool cached = vm.count("cache") > 0;
+
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using address_type = boost::asio::ip::address;
 
@@ -58,12 +64,12 @@ int main(int ac, char const* av[])
 
     if(sync)
     {
-        http_sync_server server(ep, root);
+        http_sync_server server(ep, root, cached);
         beast::test::sig_wait();
     }
     else
     {
-        http_async_server server(ep, threads, root);
+        http_async_server server(ep, threads, root, mmap, cached);
         beast::test::sig_wait();
     }
 }
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "http_async_server.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using endpoint_type = boost::asio::ip::tcp::endpoint;
+
+// Sends requests for the file on keep-alive connections,
+// returning the number of responses received per second.
+double
+load(endpoint_type const& ep, std::size_t connections,
+    std::size_t requests, std::uint64_t size)
+{
+    using namespace beast::http;
+    using clock_type = std::chrono::high_resolution_clock;
+    std::atomic<std::size_t> failures{0};
+    std::vector<std::thread> threads;
+    threads.reserve(connections);
+    auto const t0 = clock_type::now();
+    for(std::size_t i = 0; i < connections; ++i)
+        threads.emplace_back(
+            [&]
+            {
+                boost::asio::io_service ios;
+                boost::asio::ip::tcp::socket sock{ios};
+                sock.connect(ep);
+                request_v1<empty_body> req;
+                req.method = "GET";
+                req.url = "/file";
+                req.version = 11;
+                req.headers.insert("User-Agent", "http_server_bench");
+                prepare(req);
+                beast::streambuf sb;
+                for(std::size_t n = 0; n < requests; ++n)
+                {
+                    write(sock, req);
+                    response_v1<string_body> res;
+                    read(sock, sb, res);
+                    if(res.status != 200 || res.body.size() != size)
+                        ++failures;
+                }
+            });
+    for(auto& t : threads)
+        t.join();
+    auto const elapsed = std::chrono::duration_cast<
+        std::chrono::microseconds>(clock_type::now() - t0).count();
+    if(failures > 0)
+        std::cerr << failures << " failed responses" << std::endl;
+    return (1000000.0 * connections * requests) /
+        (elapsed > 0 ? elapsed : 1);
+}
+
+int main(int ac, char const* av[])
+{
+    using namespace beast::http;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+
+    desc.add_options()
+        ("size,s",      po::value<std::uint64_t>()->implicit_value(16),
+                        "Set the size of the file in kilobytes")
+        ("connections,c", po::value<std::size_t>()->implicit_value(8),
+                        "Set the number of client connections")
+        ("requests,n",  po::value<std::size_t>()->implicit_value(2000),
+                        "Set the number of requests per connection")
+        ("threads,t",   po::value<std::size_t>()->implicit_value(4),
+                        "Set the number of server threads")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    std::uint64_t size = 16;
+    if(vm.count("size"))
+        size = vm["size"].as<std::uint64_t>();
+    size *= 1024;
+
+    std::size_t connections = 8;
+    if(vm.count("connections"))
+        connections = vm["connections"].as<std::size_t>();
+
+    std::size_t requests = 2000;
+    if(vm.count("requests"))
+        requests = vm["requests"].as<std::size_t>();
+
+    std::size_t threads = 4;
+    if(vm.count("threads"))
+        threads = vm["threads"].as<std::size_t>();
+
+    auto const root = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+    boost::filesystem::create_directory(root);
+    {
+        std::ofstream os((root / "file").string(), std::ios::binary);
+        os << std::string(static_cast<std::size_t>(size), '*');
+    }
+
+    endpoint_type const ep{
+        boost::asio::ip::address_v4::loopback(), 0};
+    auto const run =
+        [&](std::string const& name,
+            bool mmap, bool cached, bool slab)
+        {
+            http_async_server server(
+                ep, threads, root.string(), mmap, cached, slab);
+            std::cout <<
+                name << ": " <<
+                static_cast<std::size_t>(load(server.local_endpoint(),
+                    connections, requests, size)) <<
+                " requests/s" << std::endl;
+        };
+    run("file_body", false, false, false);
+    run("file_body (slab_allocator)", false, false, true);
+    run("mmap_body", true, false, false);
+    run("mmap_body (slab_allocator)", true, false, true);
+    run("response_cache", false, true, false);
+
+    boost::filesystem::remove_all(root);
+}
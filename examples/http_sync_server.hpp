@@ -8,11 +8,13 @@
 #ifndef BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
+#include "response_cache.hpp"
 
+#include <beast/http/file_body.hpp>
 #include <beast/core/streambuf.hpp>
 #include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
@@ -41,14 +43,23 @@ class http_sync_server
     socket_type sock_;
     boost::asio::ip::tcp::acceptor acceptor_;
     std::string root_;
+    bool cached_;
+    response_cache cache_;
     std::thread thread_;
 
 public:
+    /** Construct the server.
+
+        If `cached` is `true`, responses to HTTP/1.1 requests are
+        sent from a @ref response_cache, without serializing them.
+    */
     http_sync_server(endpoint_type const& ep,
-            std::string const& root)
+            std::string const& root, bool cached = false)
         : sock_(ios_)
         , acceptor_(ios_)
         , root_(root)
+        , cached_(cached)
+        , cache_("http_sync_server")
     {
         acceptor_.open(ep.protocol());
         acceptor_.bind(ep);
@@ -174,6 +185,21 @@ private:
                     break;
                 return;
             }
+            if(cached_ && req.version == 11)
+            {
+                auto const e = cache_.get(path, ec);
+                if(! ec)
+                {
+                    if(e->matches(req))
+                        boost::asio::write(sock, e->not_modified(), ec);
+                    else
+                        boost::asio::write(sock, e->buffers(), ec);
+                    if(ec)
+                        break;
+                    continue;
+                }
+                ec = {};
+            }
             try
             {
                 resp_type res;
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_RESPONSE_CACHE_H_INCLUDED
+#define BEAST_EXAMPLE_RESPONSE_CACHE_H_INCLUDED
+
+#include "mime_type.hpp"
+
+#include <beast/http/empty_body.hpp>
+#include <beast/http/message_v1.hpp>
+#include <beast/http/mmap_body.hpp>
+#include <beast/http/write.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace beast {
+namespace http {
+
+/** A cache of fully serialized responses for static files.
+
+    Each entry holds the serialized start line and fields of a
+    `200 OK` response, the file contents in a read-only mapping,
+    and a complete `304 Not Modified` response. Entries carry the
+    validators `ETag` and `Last-Modified`, and are immutable and
+    shared, so a cache hit is sent with one gather write and no
+    formatting. An entry is replaced when the size or modification
+    time of its file changes.
+
+    Entries are prepared for HTTP/1.1 persistent connections.
+*/
+class response_cache
+{
+public:
+    /// A serialized response, shared between connections.
+    class entry
+    {
+        friend class response_cache;
+
+        std::string head_;
+        std::string not_modified_;
+        std::string etag_;
+        std::string last_modified_;
+        std::shared_ptr<mmap_body::mapping const> body_;
+
+    public:
+        /// Returns the value of the ETag field.
+        std::string const&
+        etag() const
+        {
+            return etag_;
+        }
+
+        /// Returns the value of the Last-Modified field.
+        std::string const&
+        last_modified() const
+        {
+            return last_modified_;
+        }
+
+        /// Returns the buffers holding the complete response.
+        std::array<boost::asio::const_buffer, 2>
+        buffers() const
+        {
+            return {{
+                boost::asio::buffer(head_),
+                boost::asio::const_buffer{body_->data(),
+                    static_cast<std::size_t>(body_->size())}}};
+        }
+
+        /// Returns the buffer holding the complete 304 response.
+        boost::asio::const_buffers_1
+        not_modified() const
+        {
+            return boost::asio::buffer(not_modified_);
+        }
+
+        /// Returns `true` if a conditional request matches the validators.
+        template<class Body, class Headers>
+        bool
+        matches(request_v1<Body, Headers> const& req) const
+        {
+            auto const inm = req.headers["If-None-Match"];
+            if(! inm.empty())
+                return inm == "*" ||
+                    inm.find(etag_) != boost::string_ref::npos;
+            return req.headers["If-Modified-Since"] == last_modified_;
+        }
+    };
+
+private:
+    std::string server_;
+    std::mutex m_;
+    std::unordered_map<std::string,
+        std::shared_ptr<entry const>> map_;
+
+public:
+    /** Construct the cache.
+
+        @param server The value of the Server field in responses.
+    */
+    explicit
+    response_cache(std::string server)
+        : server_(std::move(server))
+    {
+    }
+
+    /** Return the entry for a file, serializing it if needed.
+
+        @param path The path to the file.
+
+        @param ec Set to the error, if any occurred.
+
+        @return The entry, or `nullptr` on error.
+    */
+    std::shared_ptr<entry const>
+    get(std::string const& path, error_code& ec)
+    {
+        auto body = mmap_body::cache::instance().get(path, ec);
+        if(ec)
+            return nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            auto const it = map_.find(path);
+            if(it != map_.end() && it->second->body_ == body)
+                return it->second;
+        }
+        auto e = make_entry(path, std::move(body));
+        std::lock_guard<std::mutex> lock(m_);
+        map_[path] = e;
+        return e;
+    }
+
+    /// Remove all entries.
+    void
+    clear()
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        map_.clear();
+    }
+
+private:
+    static
+    std::string
+    http_date(std::time_t t)
+    {
+        std::tm tm;
+#ifdef _WIN32
+        ::gmtime_s(&tm, &t);
+#else
+        ::gmtime_r(&t, &tm);
+#endif
+        char buf[32];
+        auto const n = std::strftime(buf, sizeof(buf),
+            "%a, %d %b %Y %H:%M:%S GMT", &tm);
+        return std::string(buf, n);
+    }
+
+    template<class Body, class Headers>
+    static
+    std::string
+    serialize(message_v1<false, Body, Headers> const& msg)
+    {
+        std::ostringstream os;
+        os << msg;
+        return os.str();
+    }
+
+    std::shared_ptr<entry const>
+    make_entry(std::string const& path,
+        std::shared_ptr<mmap_body::mapping const> body)
+    {
+        auto e = std::make_shared<entry>();
+        {
+            // A file rewritten in place with the same size within
+            // one second must not keep its ETag, so the validator
+            // includes the inode and the full modification time.
+            std::ostringstream os;
+            os << '"' << std::hex << body->inode() <<
+                '-' << body->size() << '-' << body->mtime() <<
+                    '.' << body->mtime_nsec() << '"';
+            e->etag_ = os.str();
+        }
+        e->last_modified_ = http_date(body->mtime());
+
+        // The body is sent from the mapping, so the
+        // message only supplies the start line and fields.
+        response_v1<empty_body> res;
+        res.version = 11;
+        res.status = 200;
+        res.reason = "OK";
+        res.headers.insert("Server", server_);
+        res.headers.insert("Content-Type", mime_type(path));
+        res.headers.insert("Content-Length", body->size());
+        res.headers.insert("ETag", e->etag_);
+        res.headers.insert("Last-Modified", e->last_modified_);
+        e->head_ = serialize(res);
+
+        res.status = 304;
+        res.reason = "Not Modified";
+        res.headers.erase("Content-Type");
+        res.headers.erase("Content-Length");
+        e->not_modified_ = serialize(res);
+
+        e->body_ = std::move(body);
+        return e;
+    }
+};
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ARENA_ALLOCATOR_HPP
+#define BEAST_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace beast {
+
+class slab_arena;
+
+/** An allocator which uses an arena.
+
+    Each allocator refers to an arena, which must outlive every
+    container using it. Allocators compare equal when they refer to
+    the same arena. The allocator propagates on container copy
+    assignment, move assignment and swap, so memory never moves
+    between arenas.
+
+    @tparam T The type of objects allocated by the allocator.
+
+    @tparam Arena The type of arena, for example @ref slab_arena
+    or @ref monotonic_arena. It must provide `allocate(n)` and
+    `deallocate(p, n)` members working in bytes, and a static
+    `alignment` member giving the alignment of every block.
+*/
+template<class T, class Arena = slab_arena>
+class arena_allocator
+{
+    template<class U, class OtherArena>
+    friend class arena_allocator;
+
+    Arena* arena_;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = arena_allocator<U, Arena>;
+    };
+
+    arena_allocator() = delete;
+
+    /// Copy constructor.
+    arena_allocator(arena_allocator const&) = default;
+
+    /// Copy assignment.
+    arena_allocator& operator=(arena_allocator const&) = default;
+
+    /** Construct the allocator.
+
+        @param arena The arena to allocate from. Ownership is not
+        transferred; the caller must keep the arena alive while
+        memory from it is in use.
+    */
+    explicit
+    arena_allocator(Arena& arena)
+        : arena_(&arena)
+    {
+    }
+
+    /// Construct from an allocator for another type.
+    template<class U>
+    arena_allocator(arena_allocator<U, Arena> const& other)
+        : arena_(other.arena_)
+    {
+    }
+
+    /// Returns the arena used by the allocator.
+    Arena&
+    arena() const
+    {
+        return *arena_;
+    }
+
+    /// Allocate storage for `n` objects.
+    value_type*
+    allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= Arena::alignment,
+            "The type is over-aligned for the arena");
+        return static_cast<value_type*>(
+            arena_->allocate(n * sizeof(T)));
+    }
+
+    /// Deallocate storage for `n` objects.
+    void
+    deallocate(value_type* p, std::size_t n)
+    {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(arena_allocator const& lhs,
+        arena_allocator<U, Arena> const& rhs)
+    {
+        return lhs.arena_ == &rhs.arena();
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(arena_allocator const& lhs,
+        arena_allocator<U, Arena> const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+} // beast
+
+#endif
@@ -23,7 +23,21 @@ namespace beast {
     The implementation uses a sequence of one or more character arrays
     of varying sizes. Additional character array objects are appended to
     the sequence to accommodate changes in the size of the character
-    sequence.
+    sequence. Character arrays which are no longer needed are kept,
+    up to a limit, and used again before allocating new ones.
+
+    The size suggested for reads by `read_size_helper` adapts to the
+    traffic: while reads fill the whole output sequence it doubles,
+    up to 64KB, and when reads come back less than half full it
+    halves again, releasing the larger character arrays, so bulk
+    transfers take fewer system calls while interactive connections
+    keep small buffers. Only a call to `prepare` following a call to
+    `read_size_helper` is taken as a read; writing into the buffer
+    leaves the read size unchanged.
+
+    Copies and moves take the settings of the source: the allocation
+    size, the limit set by @ref set_max_free, and the adapted read
+    size.
 
     @note Meets the requirements of @b `DynamicBuffer`.
 
@@ -72,12 +86,18 @@ private:
             "BidirectionalIterator requirements not met");
 
     list_type list_;        // list of allocated buffers
+    list_type free_;        // buffers kept for reuse
     iterator out_;          // element that contains out_pos_
     size_type alloc_size_;  // min amount to allocate
+    std::size_t max_free_ = 2; // max size of free_
     size_type in_size_ = 0; // size of the input sequence
     size_type in_pos_ = 0;  // input offset in list_.front()
     size_type out_pos_ = 0; // output offset in *out_
     size_type out_end_ = 0; // output end offset in list_.back()
+    size_type prepared_ = 0;  // size of the last read prepared
+    mutable bool reading_ = false; // next prepare is for a read
+    size_type read_size_ = 0; // read size learned from commits
+    size_type keep_size_ = 0; // largest array kept, or zero for any
 
 public:
 #if GENERATING_DOCS
@@ -202,6 +222,21 @@ public:
     basic_streambuf(std::size_t alloc_size = 1024,
         Allocator const& alloc = allocator_type{});
 
+    /** Set the maximum number of buffers kept for reuse.
+
+        Buffers released when the input sequence is consumed, or
+        when a call to `prepare` shrinks the output sequence, are
+        kept up to this number. Later calls to `prepare` use them
+        before allocating, so data streaming through the buffer
+        does not allocate and free memory for every buffer. A value
+        of zero frees buffers as soon as they are released. The
+        default is 2.
+
+        @param n The maximum number of buffers to keep.
+    */
+    void
+    set_max_free(std::size_t n);
+
     /// Returns a copy of the associated allocator.
     allocator_type
     get_allocator() const
@@ -262,6 +297,13 @@ public:
         OtherAllocator> const& streambuf, std::size_t max_size);
 
 private:
+    template<class OtherAlloc>
+    friend class basic_streambuf;
+
+    template<class OtherAlloc>
+    void
+    copy_settings(basic_streambuf<OtherAlloc> const& other);
+
     void
     clear();
 
@@ -277,6 +319,12 @@ private:
     void
     copy_assign(basic_streambuf const& other, std::true_type);
 
+    void
+    release(element& e);
+
+    void
+    delete_element(element& e);
+
     void
     delete_list();
 
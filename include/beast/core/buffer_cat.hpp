@@ -27,6 +27,12 @@ namespace beast {
     not take ownership of the underlying memory. The application is still
     responsible for managing the lifetime of the referenced memory.
 
+    When the iterators of every input sequence are random access,
+    the iterators of the returned sequence are random access too.
+    An argument which is itself the result of `buffer_cat` is
+    replaced by the sequences it concatenates, so nested calls
+    produce a single flat concatenation.
+
     @param buffers The list of buffer sequences to concatenate.
 
     @return A new @b `ConstBufferSequence` that represents the
@@ -38,14 +44,14 @@ implementation_defined
 buffer_cat(BufferSequence const&... buffers)
 #else
 template<class B1, class B2, class... Bn>
-detail::buffer_cat_helper<
-    boost::asio::const_buffer, B1, B2, Bn...>
+detail::buffer_cat_t<B1, B2, Bn...>
 buffer_cat(B1 const& b1, B2 const& b2, Bn const&... bn)
 #endif
 {
-    return detail::buffer_cat_helper<
-        boost::asio::const_buffer,
-            B1, B2, Bn...>(b1, b2, bn...);
+    return detail::buffer_cat_t<B1, B2, Bn...>{std::tuple_cat(
+        detail::buffer_cat_flatten<B1>::get(b1),
+        detail::buffer_cat_flatten<B2>::get(b2),
+        detail::buffer_cat_flatten<Bn>::get(bn)...)};
 }
 
 } // beast
@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_CIRCULAR_STREAMBUF_HPP
+#define BEAST_CIRCULAR_STREAMBUF_HPP
+
+#ifndef _WIN32
+
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <limits>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` stored in a ring of mirrored memory.
+
+    The storage is a region of shared memory mapped twice, at
+    consecutive virtual addresses, so that the byte following the
+    end of the first mapping is the first byte of the region again.
+    The input and output sequences may wrap around the end of the
+    region while still occupying one contiguous range of addresses.
+    Consequently @ref data and @ref prepare always return a single
+    buffer, and consuming input never moves the remaining bytes.
+
+    Parsers which handle contiguous input faster than a sequence
+    of buffers, such as the HTTP parser, benefit from this layout.
+
+    The region is created on the first call to @ref prepare, and
+    grows when the sum of the sizes of the input and output sequences
+    would exceed the capacity. Growing copies the input sequence to a
+    new region. The capacity is always a multiple of the page size.
+
+    @note This class is not available on Windows.
+
+    @note Meets the requirements of @b `DynamicBuffer`.
+*/
+class circular_streambuf
+{
+    char* base_ = nullptr;      // first of the two mappings
+    std::size_t capacity_;      // size of one mapping
+    std::size_t max_;           // limit on the size of the sequences
+    std::size_t in_pos_ = 0;    // offset of the input sequence
+    std::size_t in_size_ = 0;   // size of the input sequence
+    std::size_t out_size_ = 0;  // size of the output sequence
+
+public:
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = boost::asio::const_buffers_1;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = boost::asio::mutable_buffers_1;
+
+    /// Destructor.
+    ~circular_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence and the storage
+        of the other stream buffer, and an empty output sequence.
+        The moved-from object will have no storage.
+    */
+    circular_streambuf(circular_streambuf&&);
+
+    /** Move assignment.
+
+        This object will have the input sequence and the storage
+        of the other stream buffer, and an empty output sequence.
+        The moved-from object will have no storage.
+    */
+    circular_streambuf&
+    operator=(circular_streambuf&&);
+
+    /// Copying is not allowed.
+    circular_streambuf(circular_streambuf const&) = delete;
+
+    /// Copying is not allowed.
+    circular_streambuf& operator=(circular_streambuf const&) = delete;
+
+    /** Construct a stream buffer.
+
+        No memory is mapped until the first call to @ref prepare.
+
+        @param capacity The size of the region created first. This
+        is rounded up to a multiple of the page size. The default
+        is 64KB.
+
+        @param max_size The largest capacity the buffer may grow to.
+        Calls to @ref prepare which would exceed it throw.
+    */
+    explicit
+    circular_streambuf(std::size_t capacity = 65536,
+        std::size_t max_size =
+            std::numeric_limits<std::size_t>::max());
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return in_size_;
+    }
+
+    /// Returns the permitted maximum sum of the sizes of the input and output sequence.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
+    std::size_t
+    capacity() const
+    {
+        return base_ ? capacity_ : 0;
+    }
+
+    /** Get a list of buffers that represents the input sequence.
+
+        @note These buffers remain valid across subsequent calls
+        to `prepare` which do not grow the buffer.
+    */
+    const_buffers_type
+    data() const
+    {
+        return {base_ + in_pos_, in_size_};
+    }
+
+    /** Get a list of buffers that represents the output sequence, with the given size.
+
+        @throws std::length_error if the sum of the sizes of the
+        input and output sequence would exceed the maximum size.
+
+        @throws system_error if memory could not be mapped.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /// Move bytes from the output sequence to the input sequence.
+    void
+    commit(std::size_t n)
+    {
+        if(n > out_size_)
+            n = out_size_;
+        in_size_ += n;
+        out_size_ -= n;
+    }
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    friend
+    std::size_t
+    read_size_helper(circular_streambuf const& streambuf,
+        std::size_t max_size);
+
+private:
+    void
+    reserve(std::size_t n);
+};
+
+} // beast
+
+#include <beast/core/impl/circular_streambuf.ipp>
+
+#endif
+
+#endif
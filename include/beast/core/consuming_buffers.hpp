@@ -68,7 +68,11 @@ public:
     using value_type = ValueType;
 
 #if GENERATING_DOCS
-    /// A bidirectional iterator type that may be used to read elements.
+    /** A bidirectional iterator type that may be used to read elements.
+
+        The iterator is random access when the iterator
+        of the wrapped sequence is random access.
+    */
     using const_iterator = implementation_defined;
 
 #else
@@ -14,11 +14,30 @@
 #include <new>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace beast {
 namespace detail {
 
+template<class... Iters>
+struct is_all_random_access;
+
+template<>
+struct is_all_random_access<>
+    : std::true_type
+{
+};
+
+template<class Iter, class... Iters>
+struct is_all_random_access<Iter, Iters...>
+    : std::integral_constant<bool,
+        std::is_base_of<std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category
+                >::value && is_all_random_access<Iters...>::value>
+{
+};
+
 template<class ValueType, class... Bs>
 class buffer_cat_helper
 {
@@ -40,6 +59,18 @@ public:
     {
     }
 
+    explicit
+    buffer_cat_helper(std::tuple<Bs...>&& bs)
+        : bs_(std::move(bs))
+    {
+    }
+
+    std::tuple<Bs...> const&
+    buffers() const
+    {
+        return bs_;
+    }
+
     const_iterator
     begin() const;
 
@@ -102,8 +133,10 @@ public:
     using pointer = value_type const*;
     using reference = value_type;
     using difference_type = std::ptrdiff_t;
-    using iterator_category =
-        std::bidirectional_iterator_tag;
+    using iterator_category = typename std::conditional<
+        is_all_random_access<typename Bs::const_iterator...>::value,
+            std::random_access_iterator_tag,
+                std::bidirectional_iterator_tag>::type;
 
     ~const_iterator();
     const_iterator();
@@ -149,10 +182,144 @@ public:
         return temp;
     }
 
+    // The members below are only available when the
+    // iterators of every sequence are random access.
+
+    const_iterator&
+    operator+=(difference_type n)
+    {
+        seek(position() + n);
+        return *this;
+    }
+
+    const_iterator&
+    operator-=(difference_type n)
+    {
+        seek(position() - n);
+        return *this;
+    }
+
+    const_iterator
+    operator+(difference_type n) const
+    {
+        auto temp = *this;
+        temp += n;
+        return temp;
+    }
+
+    friend
+    const_iterator
+    operator+(difference_type n, const_iterator const& it)
+    {
+        return it + n;
+    }
+
+    const_iterator
+    operator-(difference_type n) const
+    {
+        auto temp = *this;
+        temp -= n;
+        return temp;
+    }
+
+    difference_type
+    operator-(const_iterator const& other) const
+    {
+        return position() - other.position();
+    }
+
+    reference
+    operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    bool
+    operator<(const_iterator const& other) const
+    {
+        return position() < other.position();
+    }
+
+    bool
+    operator>(const_iterator const& other) const
+    {
+        return other < *this;
+    }
+
+    bool
+    operator<=(const_iterator const& other) const
+    {
+        return !(other < *this);
+    }
+
+    bool
+    operator>=(const_iterator const& other) const
+    {
+        return !(*this < other);
+    }
+
 private:
     const_iterator(
         std::tuple<Bs...> const& bs, bool at_end);
 
+    // Returns the number of elements before the iterator
+    difference_type
+    position() const
+    {
+        return position(C<0>{}, 0);
+    }
+
+    difference_type
+    position(C<sizeof...(Bs)>, difference_type n) const
+    {
+        return n;
+    }
+
+    template<std::size_t I>
+    difference_type
+    position(C<I>, difference_type n) const
+    {
+        auto const& b = std::get<I>(*bs_);
+        if(n_ == I)
+            return n + std::distance(b.begin(), iter<I>());
+        return position(C<I+1>{},
+            n + std::distance(b.begin(), b.end()));
+    }
+
+    // Moves the iterator to the element at position n
+    void
+    seek(difference_type n)
+    {
+        if(n < 0)
+            throw std::logic_error("invalid iterator");
+        destroy(C<0>{});
+        seek(C<0>{}, n);
+    }
+
+    void
+    seek(C<sizeof...(Bs)>, difference_type n)
+    {
+        n_ = sizeof...(Bs);
+        if(n != 0)
+            throw std::logic_error("invalid iterator");
+    }
+
+    template<std::size_t I>
+    void
+    seek(C<I>, difference_type n)
+    {
+        auto const& b = std::get<I>(*bs_);
+        auto const size = std::distance(b.begin(), b.end());
+        if(n < size)
+        {
+            n_ = I;
+            new(buf_.data()) iter_t<I>{
+                std::next(b.begin(), n)};
+            return;
+        }
+        seek(C<I+1>{}, n - size);
+    }
+
     void
     construct(C<sizeof...(Bs)>)
     {
@@ -465,6 +632,72 @@ buffer_cat_helper<ValueType, Bs...>::end() const ->
     return const_iterator(bs_, true);
 }
 
+//------------------------------------------------------------------------------
+
+template<class... Ts>
+struct type_list
+{
+};
+
+template<class... Lists>
+struct type_list_cat;
+
+template<class... Ts>
+struct type_list_cat<type_list<Ts...>>
+{
+    using type = type_list<Ts...>;
+};
+
+template<class... Ts, class... Us, class... Lists>
+struct type_list_cat<type_list<Ts...>, type_list<Us...>, Lists...>
+    : type_list_cat<type_list<Ts..., Us...>, Lists...>
+{
+};
+
+// Yields the sequences which a buffer_cat argument contributes.
+// A concatenation contributes its own sequences, so that nested
+// concatenations are iterated as one.
+template<class B>
+struct buffer_cat_flatten
+{
+    using type = type_list<B>;
+
+    static
+    std::tuple<B>
+    get(B const& b)
+    {
+        return std::tuple<B>{b};
+    }
+};
+
+template<class ValueType, class... Bs>
+struct buffer_cat_flatten<buffer_cat_helper<ValueType, Bs...>>
+{
+    using type = type_list<Bs...>;
+
+    static
+    std::tuple<Bs...> const&
+    get(buffer_cat_helper<ValueType, Bs...> const& b)
+    {
+        return b.buffers();
+    }
+};
+
+template<class ValueType, class List>
+struct make_buffer_cat_helper;
+
+template<class ValueType, class... Bs>
+struct make_buffer_cat_helper<ValueType, type_list<Bs...>>
+{
+    using type = buffer_cat_helper<ValueType, Bs...>;
+};
+
+// The type returned by buffer_cat for the given arguments
+template<class... Bn>
+using buffer_cat_t = typename make_buffer_cat_helper<
+    boost::asio::const_buffer, typename type_list_cat<
+        typename buffer_cat_flatten<Bn>::type...>::type>::type;
+
 } // detail
 } // beast
 
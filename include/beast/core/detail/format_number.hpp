@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_FORMAT_NUMBER_HPP
+#define BEAST_DETAIL_FORMAT_NUMBER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <type_traits>
+
+namespace beast {
+namespace detail {
+
+// Large enough to hold any number formatted by these functions
+static std::size_t constexpr max_number_chars = 40;
+
+// The decimal digits of 0 through 99, two characters each
+inline
+char const*
+digit_pairs()
+{
+    static char const s[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    return s;
+}
+
+// Determines if T is formatted as a number rather than a character
+template<class T>
+using is_formattable_integer =
+    std::integral_constant<bool,
+        std::is_integral<T>::value &&
+        ! std::is_same<T, bool>::value &&
+        ! std::is_same<T, char>::value &&
+        ! std::is_same<T, signed char>::value &&
+        ! std::is_same<T, unsigned char>::value &&
+        ! std::is_same<T, wchar_t>::value &&
+        ! std::is_same<T, char16_t>::value &&
+        ! std::is_same<T, char32_t>::value>;
+
+/*  Format an unsigned integer in decimal.
+
+    The characters are written backwards, ending just before
+    `end`. Returns a pointer to the first character.
+*/
+template<class Unsigned>
+char*
+format_uint(char* end, Unsigned v)
+{
+    auto const pairs = digit_pairs();
+    while(v >= 100)
+    {
+        auto const i = static_cast<std::size_t>(v % 100) * 2;
+        v /= 100;
+        *--end = pairs[i + 1];
+        *--end = pairs[i];
+    }
+    if(v >= 10)
+    {
+        auto const i = static_cast<std::size_t>(v) * 2;
+        *--end = pairs[i + 1];
+        *--end = pairs[i];
+    }
+    else
+    {
+        *--end = static_cast<char>('0' + v);
+    }
+    return end;
+}
+
+template<class Integer>
+char*
+format_integer(char* end, Integer v, std::true_type)
+{
+    using unsigned_type =
+        typename std::make_unsigned<Integer>::type;
+    if(v >= 0)
+        return format_uint(end, static_cast<unsigned_type>(v));
+    // Negate in unsigned arithmetic, so the
+    // minimum value does not overflow.
+    end = format_uint(end, static_cast<unsigned_type>(
+        unsigned_type{0} - static_cast<unsigned_type>(v)));
+    *--end = '-';
+    return end;
+}
+
+template<class Integer>
+char*
+format_integer(char* end, Integer v, std::false_type)
+{
+    return format_uint(end, v);
+}
+
+/*  Format an integer in decimal.
+
+    The characters are written backwards, ending just before
+    `end`. Returns a pointer to the first character.
+*/
+template<class Integer>
+char*
+format_integer(char* end, Integer v)
+{
+    return format_integer(end, v,
+        std::is_signed<Integer>{});
+}
+
+/*  Format a floating point number.
+
+    The output matches a stream with the precision set to
+    `max_digits10`, so that the value is preserved. The decimal
+    point is always '.', regardless of the global locale.
+
+    Returns the number of characters written to `buf`, which
+    must hold at least `max_number_chars` characters.
+*/
+template<class Float>
+std::size_t
+format_float(char* buf, Float v)
+{
+    int n;
+    if(std::is_same<Float, long double>::value)
+        n = std::snprintf(buf, max_number_chars, "%.*Lg",
+            std::numeric_limits<long double>::max_digits10,
+                static_cast<long double>(v));
+    else
+        n = std::snprintf(buf, max_number_chars, "%.*g",
+            std::numeric_limits<Float>::max_digits10,
+                static_cast<double>(v));
+    if(n < 0)
+        return 0;
+    if(n >= static_cast<int>(max_number_chars))
+        n = static_cast<int>(max_number_chars) - 1;
+    // The C library uses the decimal point of the C locale
+    // in effect, which may not be '.'
+    for(int i = 0; i < n; ++i)
+        if(buf[i] == ',')
+            buf[i] = '.';
+    return static_cast<std::size_t>(n);
+}
+
+} // detail
+} // beast
+
+#endif
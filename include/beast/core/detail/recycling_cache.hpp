@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_RECYCLING_CACHE_HPP
+#define BEAST_DETAIL_RECYCLING_CACHE_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace beast {
+namespace detail {
+
+/*  A per-thread cache holding one memory block of each size class.
+
+    Sizes are rounded up to a power of two from 64 to 16384 bytes.
+    A freed block is kept if the cache has no block of its class,
+    and the next request for that class takes it back. This suits
+    composed operations, which usually free the state of one step
+    just before the next step allocates the same amount.
+
+    Blocks come from global operator new, so a block may be freed
+    on any thread. The blocks cached by a thread are released when
+    the thread exits.
+*/
+class recycling_cache
+{
+public:
+    // Number of size classes
+    static std::size_t constexpr count = 9;
+
+    // Smallest block size
+    static std::size_t constexpr min_size = 64;
+
+    // Largest size served from a size class
+    static std::size_t constexpr max_size = min_size << (count - 1);
+
+    static
+    void*
+    allocate(std::size_t n)
+    {
+        if(n > max_size)
+            return ::operator new(n);
+        auto const i = index(n);
+        auto& s = local();
+        if(auto const p = s.blocks[i])
+        {
+            s.blocks[i] = nullptr;
+            return p;
+        }
+        return ::operator new(min_size << i);
+    }
+
+    static
+    void
+    deallocate(void* p, std::size_t n)
+    {
+        if(n <= max_size)
+        {
+            auto const i = index(n);
+            auto& s = local();
+            if(! s.closed && ! s.blocks[i])
+            {
+                s.blocks[i] = p;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+    // Returns the class for a size in [0, max_size]
+    static
+    std::size_t
+    index(std::size_t n)
+    {
+        std::size_t i = 0;
+        while((min_size << i) < n)
+            ++i;
+        return i;
+    }
+
+private:
+    // Trivially destructible, so it remains
+    // usable while the thread is exiting.
+    struct state
+    {
+        void* blocks[count];
+        bool closed;
+    };
+
+    // Releases the cached blocks when the thread exits
+    class cleanup
+    {
+    public:
+        ~cleanup()
+        {
+            auto& s = slots();
+            s.closed = true;
+            for(auto& p : s.blocks)
+            {
+                ::operator delete(p);
+                p = nullptr;
+            }
+        }
+    };
+
+    static
+    state&
+    slots()
+    {
+        static thread_local state s;
+        return s;
+    }
+
+    static
+    state&
+    local()
+    {
+        static thread_local cleanup c;
+        (void)c;
+        return slots();
+    }
+};
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_RECYCLING_HANDLER_HPP
+#define BEAST_DETAIL_RECYCLING_HANDLER_HPP
+
+#include <beast/core/detail/recycling_cache.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace detail {
+
+/*  Handler which allocates from the per-thread recycling cache.
+
+    The call operator, continuation and invocation hooks go to
+    the wrapped handler, so a handler wrapped by a strand keeps its
+    execution guarantees. Only the allocation hooks are replaced.
+*/
+template<class Handler>
+class recycling_handler
+{
+    Handler h_;
+
+public:
+    using result_type = void;
+
+    recycling_handler(recycling_handler&&) = default;
+    recycling_handler(recycling_handler const&) = default;
+
+    template<class DeducedHandler, class = typename
+        std::enable_if<! std::is_same<typename
+            std::decay<DeducedHandler>::type,
+                recycling_handler>::value>::type>
+    explicit
+    recycling_handler(DeducedHandler&& handler)
+        : h_(std::forward<DeducedHandler>(handler))
+    {
+    }
+
+    template<class... Args>
+    void
+    operator()(Args&&... args)
+    {
+        h_(std::forward<Args>(args)...);
+    }
+
+    friend
+    void*
+    asio_handler_allocate(
+        std::size_t size, recycling_handler*)
+    {
+        return recycling_cache::allocate(size);
+    }
+
+    friend
+    void
+    asio_handler_deallocate(
+        void* p, std::size_t size, recycling_handler*)
+    {
+        recycling_cache::deallocate(p, size);
+    }
+
+    friend
+    bool
+    asio_handler_is_continuation(recycling_handler* h)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(h->h_);
+    }
+
+    template<class F>
+    friend
+    void
+    asio_handler_invoke(F&& f, recycling_handler* h)
+    {
+        boost_asio_handler_invoke_helpers::
+            invoke(f, h->h_);
+    }
+};
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,332 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_SLAB_CACHE_HPP
+#define BEAST_DETAIL_SLAB_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace beast {
+namespace detail {
+
+/*  Size classes for small allocations.
+
+    Sizes up to 128 are rounded up to a multiple of 16. Above
+    that, each power of two is divided into four classes, so
+    no more than a fifth of a block is wasted. Every class is
+    a multiple of 16, which keeps blocks aligned for any type.
+*/
+struct slab_sizes
+{
+    // Number of size classes
+    static std::size_t constexpr count = 36;
+
+    // Largest size served from a size class
+    static std::size_t constexpr max_size = 16384;
+
+    // Alignment of every block
+    static std::size_t constexpr align = 16;
+
+    static
+    std::size_t
+    floor_log2(std::size_t n)
+    {
+    #if defined(__GNUC__)
+        return sizeof(unsigned long) * 8 - 1 -
+            __builtin_clzl(static_cast<unsigned long>(n));
+    #else
+        std::size_t k = 0;
+        while(n >>= 1)
+            ++k;
+        return k;
+    #endif
+    }
+
+    // Returns the class for a size in [1, max_size]
+    static
+    std::size_t
+    index(std::size_t n)
+    {
+        if(n <= 128)
+            return n == 0 ? 0 : (n - 1) >> 4;
+        auto const k = floor_log2(n - 1);
+        return 8 + (k - 7) * 4 +
+            ((n - 1 - (std::size_t{1} << k)) >> (k - 2));
+    }
+
+    // Returns the block size of a class
+    static
+    std::size_t
+    size(std::size_t i)
+    {
+        if(i < 8)
+            return (i + 1) * 16;
+        auto const k = 7 + (i - 8) / 4;
+        return (std::size_t{1} << k) +
+            ((i - 8) % 4 + 1) * (std::size_t{1} << (k - 2));
+    }
+};
+
+/*  A size-classed cache of memory blocks owned by one thread.
+
+    Blocks are carved from slabs of `slab_size` bytes, each
+    holding blocks of a single class and aligned to its size,
+    so the slab and its owner are found from any block address.
+    Blocks freed by the owning thread go straight back to the
+    free list of their class. Blocks freed by other threads are
+    pushed onto a lock-free list, which the owner takes back in
+    one step when a free list runs dry.
+
+    Caches are never destroyed, so a block may be freed at any
+    time, even during static destruction. When a thread exits its
+    cache is parked, and the next new thread adopts it along with
+    the blocks freed to it meanwhile. A thread which only frees
+    blocks never gets a cache of its own.
+*/
+class slab_cache
+{
+public:
+    static std::size_t constexpr slab_size = 65536;
+
+private:
+    static std::size_t constexpr slabs_per_chunk = 16;
+
+    struct block
+    {
+        block* next;
+    };
+
+    struct slab_header
+    {
+        slab_cache* owner;
+        std::size_t size;
+    };
+
+    static std::size_t constexpr header_size =
+        (sizeof(slab_header) + slab_sizes::align - 1) &
+            ~(slab_sizes::align - 1);
+
+    block* free_[slab_sizes::count] = {};
+    char* next_[slab_sizes::count] = {};
+    char* end_[slab_sizes::count] = {};
+    char* slab_ = nullptr;      // next unused slab
+    char* slab_end_ = nullptr;  // end of the unused slabs
+    std::vector<void*> chunks_;
+    std::atomic<block*> remote_{nullptr};
+
+    class registry;
+    class holder;
+
+public:
+    slab_cache() = default;
+    slab_cache(slab_cache const&) = delete;
+    slab_cache& operator=(slab_cache const&) = delete;
+
+    ~slab_cache()
+    {
+        for(auto p : chunks_)
+            ::operator delete(p);
+    }
+
+    // Returns the cache of the calling thread
+    static
+    slab_cache&
+    local();
+
+    // Returns the cache of the calling thread, or null if it has
+    // none. Trivially destructible, so it remains usable while the
+    // thread exits.
+    static
+    slab_cache*&
+    current()
+    {
+        static thread_local slab_cache* p = nullptr;
+        return p;
+    }
+
+    // Allocate a block of at most slab_sizes::max_size bytes
+    void*
+    allocate(std::size_t n)
+    {
+        auto const i = slab_sizes::index(n);
+        if(auto const b = free_[i])
+        {
+            free_[i] = b->next;
+            return b;
+        }
+        return allocate_slow(i);
+    }
+
+    // Free a block allocated from any cache
+    static
+    void
+    deallocate(void* p)
+    {
+        auto const h = reinterpret_cast<slab_header*>(
+            reinterpret_cast<std::uintptr_t>(p) &
+                ~static_cast<std::uintptr_t>(slab_size - 1));
+        auto const b = static_cast<block*>(p);
+        auto const owner = h->owner;
+        if(owner == current())
+        {
+            auto const i = slab_sizes::index(h->size);
+            b->next = owner->free_[i];
+            owner->free_[i] = b;
+            return;
+        }
+        b->next = owner->remote_.load(std::memory_order_relaxed);
+        while(! owner->remote_.compare_exchange_weak(b->next, b,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+private:
+    void*
+    allocate_slow(std::size_t i)
+    {
+        if(remote_.load(std::memory_order_relaxed))
+        {
+            reclaim();
+            if(auto const b = free_[i])
+            {
+                free_[i] = b->next;
+                return b;
+            }
+        }
+        auto const size = slab_sizes::size(i);
+        if(static_cast<std::size_t>(end_[i] - next_[i]) < size)
+        {
+            auto const s = new_slab();
+            auto const h = reinterpret_cast<slab_header*>(s);
+            h->owner = this;
+            h->size = size;
+            next_[i] = s + header_size;
+            end_[i] = s + slab_size;
+        }
+        auto const p = next_[i];
+        next_[i] += size;
+        return p;
+    }
+
+    // Take back the blocks freed by other threads
+    void
+    reclaim()
+    {
+        auto b = remote_.exchange(
+            nullptr, std::memory_order_acquire);
+        while(b)
+        {
+            auto const next = b->next;
+            auto const h = reinterpret_cast<slab_header*>(
+                reinterpret_cast<std::uintptr_t>(b) &
+                    ~static_cast<std::uintptr_t>(slab_size - 1));
+            auto const i = slab_sizes::index(h->size);
+            b->next = free_[i];
+            free_[i] = b;
+            b = next;
+        }
+    }
+
+    char*
+    new_slab()
+    {
+        if(slab_ == slab_end_)
+        {
+            // One extra slab leaves room to align the rest
+            auto const p = ::operator new(
+                (slabs_per_chunk + 1) * slab_size);
+            chunks_.push_back(p);
+            auto const u = reinterpret_cast<std::uintptr_t>(p);
+            slab_ = reinterpret_cast<char*>(
+                (u + slab_size - 1) &
+                    ~static_cast<std::uintptr_t>(slab_size - 1));
+            slab_end_ = slab_ + slabs_per_chunk * slab_size;
+        }
+        auto const s = slab_;
+        slab_ += slab_size;
+        return s;
+    }
+};
+
+// Holds the caches of exited threads
+class slab_cache::registry
+{
+    std::mutex m_;
+    std::vector<slab_cache*> idle_;
+
+public:
+    // Never destroyed, blocks may outlive static objects
+    static
+    registry&
+    instance()
+    {
+        static registry& r = *new registry;
+        return r;
+    }
+
+    slab_cache*
+    acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            if(! idle_.empty())
+            {
+                auto const c = idle_.back();
+                idle_.pop_back();
+                return c;
+            }
+        }
+        return new slab_cache;
+    }
+
+    void
+    release(slab_cache* c)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        idle_.push_back(c);
+    }
+};
+
+class slab_cache::holder
+{
+    registry& r_;
+
+public:
+    slab_cache* const cache;
+
+    holder()
+        : r_(registry::instance())
+        , cache(r_.acquire())
+    {
+        current() = cache;
+    }
+
+    ~holder()
+    {
+        current() = nullptr;
+        r_.release(cache);
+    }
+};
+
+inline
+slab_cache&
+slab_cache::local()
+{
+    static thread_local holder h;
+    return *h.cache;
+}
+
+} // detail
+} // beast
+
+#endif
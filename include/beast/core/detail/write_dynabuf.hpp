@@ -9,6 +9,7 @@
 #define BEAST_DETAIL_WRITE_DYNABUF_HPP
 
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/detail/format_number.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/lexical_cast.hpp>
 #include <utility>
@@ -110,6 +111,36 @@ write_dynabuf(DynamicBuffer& dynabuf, const char (&s)[N])
 
 template<class DynamicBuffer, class T>
 typename std::enable_if<
+    is_formattable_integer<T>::value
+>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer_copy;
+    char buf[max_number_chars];
+    auto const end = buf + sizeof(buf);
+    auto const first = format_integer(end, t);
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(end - first),
+            boost::asio::buffer(first, end - first)));
+}
+
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    std::is_floating_point<T>::value
+>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer_copy;
+    char buf[max_number_chars];
+    auto const n = format_float(buf, t);
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(n), boost::asio::buffer(buf, n)));
+}
+
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    ! is_formattable_integer<T>::value &&
+    ! std::is_floating_point<T>::value &&
     ! is_string_literal<T>::value &&
     ! is_ConstBufferSequence<T>::value &&
     ! is_BufferConvertible<T>::value &&
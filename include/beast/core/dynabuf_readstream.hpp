@@ -13,6 +13,7 @@
 #include <beast/core/error.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/streambuf.hpp>
+#include <beast/core/detail/buffer_cat.hpp>
 #include <beast/core/detail/get_lowest_layer.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
@@ -98,6 +99,7 @@ class dynabuf_readstream
 
     DynamicBuffer sb_;
     std::size_t capacity_ = 0;
+    bool vectored_ = false;
     Stream next_layer_;
 
 public:
@@ -214,6 +216,33 @@ public:
         capacity_ = size;
     }
 
+    /** Set whether reads fill the caller's buffers and the internal buffer together.
+
+        When this is enabled, the internal buffer is empty, and the
+        buffer size is not zero, a read is issued on the next layer
+        with a buffer sequence made of the caller's buffers followed
+        by up to @ref capacity bytes of the internal buffer. Data fills
+        the caller's buffers first, without a copy, while any excess is
+        kept in the internal buffer for subsequent reads. A protocol
+        which alternates small headers with larger payloads, such as
+        WebSocket, then usually receives the next header along with
+        the current payload in a single system call.
+
+        When this is disabled, which is the default, such a read goes
+        into the internal buffer only and is then copied out.
+
+        Thread safety:
+            The caller is responsible for making sure the call is
+            made from the same implicit or explicit strand.
+
+        @param value `true` to enable vectored reads.
+    */
+    void
+    vectored(bool value)
+    {
+        vectored_ = value;
+    }
+
     /// Write the given data to the stream. Returns the number of bytes written.
     /// Throws an exception on failure.
     template<class ConstBufferSequence>
@@ -267,10 +296,23 @@ public:
 #if GENERATING_DOCS
     void_or_deduced
 #else
-    typename async_completion<ReadHandler, void(error_code)>::result_type
+    typename async_completion<ReadHandler, void(error_code, std::size_t)>::result_type
 #endif
     async_read_some(MutableBufferSequence const& buffers,
         ReadHandler&& handler);
+
+private:
+    template<class MutableBufferSequence>
+    detail::buffer_cat_helper<boost::asio::mutable_buffer,
+        MutableBufferSequence, typename
+            DynamicBuffer::mutable_buffers_type>
+    vectored_buffers(MutableBufferSequence const& buffers)
+    {
+        return detail::buffer_cat_helper<
+            boost::asio::mutable_buffer, MutableBufferSequence,
+                typename DynamicBuffer::mutable_buffers_type>(
+                    buffers, sb_.prepare(capacity_));
+    }
 };
 
 } // beast
@@ -403,14 +403,18 @@ basic_streambuf(basic_streambuf&& other)
     : detail::empty_base_optimization<allocator_type>(
         std::move(other.member()))
     , alloc_size_(other.alloc_size_)
+    , max_free_(other.max_free_)
     , in_size_(other.in_size_)
     , in_pos_(other.in_pos_)
     , out_pos_(other.out_pos_)
     , out_end_(other.out_end_)
+    , read_size_(other.read_size_)
+    , keep_size_(other.keep_size_)
 {
     auto const at_end =
         other.out_ == other.list_.end();
     list_ = std::move(other.list_);
+    free_ = std::move(other.free_);
     out_ = at_end ? list_.end() : other.out_;
     other.in_size_ = 0;
     other.out_ = other.list_.end();
@@ -426,6 +430,7 @@ basic_streambuf(basic_streambuf&& other,
     : basic_streambuf(other.alloc_size_, alloc)
 {
     using boost::asio::buffer_copy;
+    copy_settings(other);
     if(this->member() != other.member())
         commit(buffer_copy(prepare(other.size()), other.data()));
     else
@@ -441,7 +446,7 @@ basic_streambuf<Allocator>::operator=(
         return *this;
     // VFALCO If any memory allocated we could use it first?
     clear();
-    alloc_size_ = other.alloc_size_;
+    copy_settings(other);
     move_assign(other, std::integral_constant<bool,
         alloc_traits::propagate_on_container_move_assignment::value>{});
     return *this;
@@ -453,6 +458,7 @@ basic_streambuf(basic_streambuf const& other)
     : basic_streambuf(other.alloc_size_,
         alloc_traits::select_on_container_copy_construction(other.member()))
 {
+    copy_settings(other);
     commit(boost::asio::buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -462,6 +468,7 @@ basic_streambuf(basic_streambuf const& other,
         allocator_type const& alloc)
     : basic_streambuf(other.alloc_size_, alloc)
 {
+    copy_settings(other);
     commit(boost::asio::buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -475,6 +482,7 @@ basic_streambuf<Allocator>::operator=(
         return *this;
     using boost::asio::buffer_copy;
     clear();
+    copy_settings(other);
     copy_assign(other, std::integral_constant<bool,
         alloc_traits::propagate_on_container_copy_assignment::value>{});
     commit(buffer_copy(prepare(other.size()), other.data()));
@@ -488,6 +496,7 @@ basic_streambuf<Allocator>::basic_streambuf(
     : basic_streambuf(other.alloc_size_)
 {
     using boost::asio::buffer_copy;
+    copy_settings(other);
     commit(buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -499,6 +508,7 @@ basic_streambuf<Allocator>::basic_streambuf(
     : basic_streambuf(other.alloc_size_, alloc)
 {
     using boost::asio::buffer_copy;
+    copy_settings(other);
     commit(buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -511,6 +521,7 @@ basic_streambuf<Allocator>::operator=(
 {
     using boost::asio::buffer_copy;
     clear();
+    copy_settings(other);
     commit(buffer_copy(prepare(other.size()), other.data()));
     return *this;
 }
@@ -527,6 +538,31 @@ basic_streambuf<Allocator>::basic_streambuf(
             "basic_streambuf: invalid alloc_size");
 }
 
+template<class Allocator>
+template<class OtherAlloc>
+void
+basic_streambuf<Allocator>::
+copy_settings(basic_streambuf<OtherAlloc> const& other)
+{
+    alloc_size_ = other.alloc_size_;
+    max_free_ = other.max_free_;
+    read_size_ = other.read_size_;
+    keep_size_ = other.keep_size_;
+}
+
+template<class Allocator>
+void
+basic_streambuf<Allocator>::set_max_free(std::size_t n)
+{
+    max_free_ = n;
+    while(free_.size() > max_free_)
+    {
+        auto& e = free_.front();
+        free_.pop_front();
+        delete_element(e);
+    }
+}
+
 template<class Allocator>
 std::size_t
 basic_streambuf<Allocator>::capacity() const
@@ -554,6 +590,8 @@ auto
 basic_streambuf<Allocator>::prepare(size_type n) ->
     mutable_buffers_type
 {
+    prepared_ = reading_ ? n : 0;
+    reading_ = false;
     list_type reuse;
     if(out_ != list_.end())
     {
@@ -594,6 +632,25 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
         }
         debug_check();
     }
+    while(n > 0 && ! free_.empty())
+    {
+        auto& e = free_.front();
+        free_.pop_front();
+        list_.push_back(e);
+        if(out_ == list_.end())
+            out_ = list_.iterator_to(e);
+        if(n >= e.size())
+        {
+            out_end_ = e.size();
+            n -= e.size();
+        }
+        else
+        {
+            out_end_ = n;
+            n = 0;
+        }
+        debug_check();
+    }
     while(n > 0)
     {
         auto const size = std::max(alloc_size_, n);
@@ -616,14 +673,11 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
         }
         debug_check();
     }
-    for(auto it = reuse.begin(); it != reuse.end();)
+    while(! reuse.empty())
     {
-        auto& e = *it++;
-        reuse.erase(list_.iterator_to(e));
-        auto const len = e.size() + sizeof(e);
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(this->member(),
-            reinterpret_cast<std::uint8_t*>(&e), len);
+        auto& e = reuse.front();
+        reuse.pop_front();
+        release(e);
     }
     return mutable_buffers_type(*this);
 }
@@ -632,6 +686,26 @@ template<class Allocator>
 void
 basic_streambuf<Allocator>::commit(size_type n)
 {
+    // Only reads of at least the smallest read size are
+    // counted, so a short read of a tiny output is ignored.
+    if(prepared_ >= 512)
+    {
+        if(n >= prepared_)
+        {
+            // The read filled the output, more is likely waiting
+            read_size_ = std::min<size_type>(
+                65536, std::max(read_size_, prepared_) * 2);
+            keep_size_ = 0;
+        }
+        else if(n < prepared_ / 2)
+        {
+            read_size_ /= 2;
+            if(read_size_ < 512)
+                read_size_ = 0;
+            keep_size_ = std::max(alloc_size_, read_size_);
+        }
+    }
+    prepared_ = 0;
     if(list_.empty())
         return;
     if(out_ == list_.end())
@@ -692,10 +766,7 @@ basic_streambuf<Allocator>::consume(size_type n)
             in_pos_ = 0;
             auto& e = list_.front();
             list_.erase(list_.iterator_to(e));
-            auto const len = e.size() + sizeof(e);
-            alloc_traits::destroy(this->member(), &e);
-            alloc_traits::deallocate(this->member(),
-                reinterpret_cast<std::uint8_t*>(&e), len);
+            release(e);
             debug_check();
         }
         else
@@ -714,10 +785,22 @@ basic_streambuf<Allocator>::consume(size_type n)
                 {
                     in_pos_ = out_pos_;
                 }
+                else if(keep_size_ != 0 &&
+                    out_->size() > keep_size_)
+                {
+                    // Input and output sequences are empty, and the
+                    // buffer is larger than current reads need.
+                    in_pos_ = 0;
+                    out_pos_ = 0;
+                    out_end_ = 0;
+                    auto& e = list_.front();
+                    list_.erase(list_.iterator_to(e));
+                    out_ = list_.end();
+                    release(e);
+                }
                 else
                 {
                     // Input and output sequences are empty, reuse buffer.
-                    // Alternatively we could deallocate it.
                     in_pos_ = 0;
                     out_pos_ = 0;
                     out_end_ = 0;
@@ -736,6 +819,7 @@ clear()
 {
     delete_list();
     list_.clear();
+    free_.clear();
     out_ = list_.begin();
     in_size_ = 0;
     in_pos_ = 0;
@@ -767,6 +851,7 @@ move_assign(basic_streambuf& other, std::true_type)
     auto const at_end =
         other.out_ == other.list_.end();
     list_ = std::move(other.list_);
+    free_ = std::move(other.free_);
     out_ = at_end ? list_.end() : other.out_;
 
     in_size_ = other.in_size_;
@@ -796,18 +881,36 @@ copy_assign(basic_streambuf const& other, std::true_type)
     this->member() = other.member();
 }
 
+template<class Allocator>
+void
+basic_streambuf<Allocator>::release(element& e)
+{
+    // Large arrays are kept only while reads are still large
+    if(free_.size() < max_free_ &&
+            (keep_size_ == 0 || e.size() <= keep_size_))
+        free_.push_back(e);
+    else
+        delete_element(e);
+}
+
+template<class Allocator>
+void
+basic_streambuf<Allocator>::delete_element(element& e)
+{
+    auto const n = e.size() + sizeof(e);
+    alloc_traits::destroy(this->member(), &e);
+    alloc_traits::deallocate(this->member(),
+        reinterpret_cast<std::uint8_t*>(&e), n);
+}
+
 template<class Allocator>
 void
 basic_streambuf<Allocator>::delete_list()
 {
     for(auto iter = list_.begin(); iter != list_.end();)
-    {
-        auto& e = *iter++;
-        auto const n = e.size() + sizeof(e);
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(this->member(),
-            reinterpret_cast<std::uint8_t*>(&e), n);
-    }
+        delete_element(*iter++);
+    for(auto iter = free_.begin(); iter != free_.end();)
+        delete_element(*iter++);
 }
 
 template<class Allocator>
@@ -855,6 +958,13 @@ std::size_t
 read_size_helper(basic_streambuf<
     Allocator> const& streambuf, std::size_t max_size)
 {
+    // The caller prepares the next output for a read
+    streambuf.reading_ = true;
+    // Once the traffic shows a size, use it even when more
+    // is allocated, so that prepare releases the surplus.
+    if(streambuf.read_size_ > 0)
+        return std::min<std::size_t>(
+            max_size, streambuf.read_size_);
     auto const avail = streambuf.capacity() - streambuf.size();
     if(avail == 0)
         return std::min(max_size,
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+#define BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+
+#include <beast/core/error.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace beast {
+
+namespace detail {
+
+inline
+std::size_t
+page_size()
+{
+    static std::size_t const size =
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// Returns a descriptor for an unnamed file in memory
+inline
+int
+open_anonymous_file()
+{
+#if defined(__linux__) && defined(SYS_memfd_create) && defined(MFD_CLOEXEC)
+    {
+        auto const fd = static_cast<int>(::syscall(SYS_memfd_create,
+            "beast::circular_streambuf", MFD_CLOEXEC));
+        // Older kernels lack memfd_create
+        if(fd != -1 || errno != ENOSYS)
+            return fd;
+    }
+#endif
+    char path[] = "/tmp/beast-XXXXXX";
+    auto const fd = ::mkstemp(path);
+    if(fd != -1)
+        ::unlink(path);
+    return fd;
+}
+
+/*  Map `size` bytes of shared memory twice, back to back.
+
+    `size` must be a multiple of the page size. Returns
+    the address of the first of the two mappings.
+*/
+inline
+char*
+map_mirrored(std::size_t size)
+{
+    auto const last_error =
+        []
+        {
+            return error_code{errno,
+                boost::system::system_category()};
+        };
+    auto const fd = open_anonymous_file();
+    if(fd == -1)
+        throw system_error{last_error()};
+    if(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        auto const ec = last_error();
+        ::close(fd);
+        throw system_error{ec};
+    }
+    // Reserve the addresses for both mappings first,
+    // so nothing else can be placed in between.
+    auto const p = ::mmap(nullptr, 2 * size,
+        PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED)
+    {
+        auto const ec = last_error();
+        ::close(fd);
+        throw system_error{ec};
+    }
+    auto const base = static_cast<char*>(p);
+    if(::mmap(base, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        ::mmap(base + size, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        auto const ec = last_error();
+        ::munmap(base, 2 * size);
+        ::close(fd);
+        throw system_error{ec};
+    }
+    // The mappings keep the memory alive
+    ::close(fd);
+    return base;
+}
+
+inline
+void
+unmap_mirrored(char* base, std::size_t size)
+{
+    ::munmap(base, 2 * size);
+}
+
+} // detail
+
+inline
+circular_streambuf::~circular_streambuf()
+{
+    if(base_)
+        detail::unmap_mirrored(base_, capacity_);
+}
+
+inline
+circular_streambuf::
+circular_streambuf(circular_streambuf&& other)
+    : base_(other.base_)
+    , capacity_(other.capacity_)
+    , max_(other.max_)
+    , in_pos_(other.in_pos_)
+    , in_size_(other.in_size_)
+{
+    other.base_ = nullptr;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+}
+
+inline
+auto
+circular_streambuf::operator=(
+    circular_streambuf&& other) -> circular_streambuf&
+{
+    if(this == &other)
+        return *this;
+    if(base_)
+        detail::unmap_mirrored(base_, capacity_);
+    base_ = other.base_;
+    capacity_ = other.capacity_;
+    max_ = other.max_;
+    in_pos_ = other.in_pos_;
+    in_size_ = other.in_size_;
+    out_size_ = 0;
+    other.base_ = nullptr;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+    return *this;
+}
+
+inline
+circular_streambuf::
+circular_streambuf(std::size_t capacity, std::size_t max_size)
+    : max_(max_size)
+{
+    auto const page = detail::page_size();
+    capacity = std::max<std::size_t>(capacity, 1);
+    capacity_ = (capacity + page - 1) / page * page;
+}
+
+inline
+auto
+circular_streambuf::prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n > max_ - in_size_)
+        throw std::length_error{
+            "circular_streambuf overflow"};
+    if(! base_ || n > capacity_ - in_size_)
+        reserve(in_size_ + n);
+    out_size_ = n;
+    return {base_ + in_pos_ + in_size_, n};
+}
+
+inline
+void
+circular_streambuf::consume(std::size_t n)
+{
+    if(n >= in_size_)
+    {
+        in_pos_ += in_size_;
+        in_size_ = 0;
+        // Start over at the beginning, to touch fewer pages
+        if(out_size_ == 0)
+            in_pos_ = 0;
+    }
+    else
+    {
+        in_pos_ += n;
+        in_size_ -= n;
+    }
+    if(in_pos_ >= capacity_)
+        in_pos_ -= capacity_;
+}
+
+inline
+void
+circular_streambuf::reserve(std::size_t n)
+{
+    // Grow geometrically, up to the maximum size
+    auto size = capacity_;
+    if(base_)
+        size = capacity_ > max_ / 2 ? max_ : capacity_ * 2;
+    size = std::max(size, n);
+    auto const page = detail::page_size();
+    size = (size + page - 1) / page * page;
+    auto const base = detail::map_mirrored(size);
+    if(base_)
+    {
+        std::memcpy(base, base_ + in_pos_, in_size_);
+        detail::unmap_mirrored(base_, capacity_);
+    }
+    base_ = base;
+    capacity_ = size;
+    in_pos_ = 0;
+}
+
+inline
+std::size_t
+read_size_helper(circular_streambuf const& streambuf,
+    std::size_t max_size)
+{
+    auto const avail = streambuf.capacity() - streambuf.size();
+    if(avail > 0)
+        return std::min(max_size, avail);
+    // The buffer is not yet mapped, or it is full and will grow
+    return std::min({max_size, streambuf.capacity_,
+        streambuf.max_ - streambuf.size()});
+}
+
+} // beast
+
+#endif
@@ -35,8 +35,12 @@ public:
     using pointer = value_type const*;
     using reference = value_type;
     using difference_type = std::ptrdiff_t;
-    using iterator_category =
-        std::bidirectional_iterator_tag;
+    using iterator_category = typename std::conditional<
+        std::is_base_of<std::random_access_iterator_tag,
+            typename std::iterator_traits<
+                iter_type>::iterator_category>::value,
+                    std::random_access_iterator_tag,
+                        std::bidirectional_iterator_tag>::type;
 
     const_iterator() = default;
     const_iterator(const_iterator&& other) = default;
@@ -96,6 +100,78 @@ public:
         return temp;
     }
 
+    // The members below are only available when
+    // the wrapped iterator is random access.
+
+    const_iterator&
+    operator+=(difference_type n)
+    {
+        it_ += n;
+        return *this;
+    }
+
+    const_iterator&
+    operator-=(difference_type n)
+    {
+        it_ -= n;
+        return *this;
+    }
+
+    const_iterator
+    operator+(difference_type n) const
+    {
+        return const_iterator{*b_, it_ + n};
+    }
+
+    friend
+    const_iterator
+    operator+(difference_type n, const_iterator const& it)
+    {
+        return it + n;
+    }
+
+    const_iterator
+    operator-(difference_type n) const
+    {
+        return const_iterator{*b_, it_ - n};
+    }
+
+    difference_type
+    operator-(const_iterator const& other) const
+    {
+        return it_ - other.it_;
+    }
+
+    reference
+    operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    bool
+    operator<(const_iterator const& other) const
+    {
+        return it_ < other.it_;
+    }
+
+    bool
+    operator>(const_iterator const& other) const
+    {
+        return other.it_ < it_;
+    }
+
+    bool
+    operator<=(const_iterator const& other) const
+    {
+        return !(other.it_ < it_);
+    }
+
+    bool
+    operator>=(const_iterator const& other) const
+    {
+        return !(it_ < other.it_);
+    }
+
 private:
     const_iterator(consuming_buffers const& b,
             iter_type it)
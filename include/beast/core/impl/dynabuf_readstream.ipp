@@ -109,8 +109,12 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
         case 0:
             if(d.srs.sb_.size() == 0)
             {
-                d.state =
-                    d.srs.capacity_ > 0 ? 2 : 1;
+                if(d.srs.capacity_ == 0)
+                    d.state = 1;
+                else if(d.srs.vectored_)
+                    d.state = 5;
+                else
+                    d.state = 2;
                 break;
             }
             d.state = 4;
@@ -148,6 +152,29 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
             // call handler
             d.state = 99;
             break;
+
+        case 5:
+            // read (vectored)
+            d.state = 6;
+            d.srs.next_layer_.async_read_some(
+                d.srs.vectored_buffers(d.bs),
+                    std::move(*this));
+            return;
+
+        // got data
+        case 6:
+        {
+            auto const size =
+                boost::asio::buffer_size(d.bs);
+            if(bytes_transferred > size)
+            {
+                d.srs.sb_.commit(bytes_transferred - size);
+                bytes_transferred = size;
+            }
+            // call handler
+            d.state = 99;
+            break;
+        }
         }
     }
     d.h(ec, bytes_transferred);
@@ -221,6 +248,18 @@ read_some(MutableBufferSequence const& buffers,
     {
         if(capacity_ == 0)
             return next_layer_.read_some(buffers, ec);
+        if(vectored_)
+        {
+            auto bytes_transferred = next_layer_.read_some(
+                vectored_buffers(buffers), ec);
+            auto const size = buffer_size(buffers);
+            if(bytes_transferred > size)
+            {
+                sb_.commit(bytes_transferred - size);
+                bytes_transferred = size;
+            }
+            return bytes_transferred;
+        }
         sb_.commit(next_layer_.read_some(
             sb_.prepare(capacity_), ec));
         if(ec)
@@ -240,7 +279,7 @@ async_read_some(
     MutableBufferSequence const& buffers,
         ReadHandler&& handler) ->
             typename async_completion<
-                ReadHandler, void(error_code)>::result_type
+                ReadHandler, void(error_code, std::size_t)>::result_type
 {
     static_assert(is_AsyncReadStream<next_layer_type>::value,
         "Stream requirements not met");
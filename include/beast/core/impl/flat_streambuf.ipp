@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_FLAT_STREAMBUF_IPP
+#define BEAST_IMPL_FLAT_STREAMBUF_IPP
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace beast {
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+~basic_flat_streambuf()
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+    , max_(other.max_)
+{
+    move_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf&& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    clear();
+    max_ = other.max_;
+    move_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_move_assignment::value>{});
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other)
+    : detail::empty_base_optimization<allocator_type>(
+        alloc_traits::select_on_container_copy_construction(
+            other.member()))
+    , max_(other.max_)
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf const& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    copy_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_copy_assignment::value>{});
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(std::size_t max_size, Allocator const& alloc)
+    : detail::empty_base_optimization<allocator_type>(alloc)
+    , max_(max_size)
+{
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n <= static_cast<std::size_t>(end_ - out_))
+    {
+        last_ = out_ + n;
+        return {out_, n};
+    }
+    auto const len = size();
+    if(n > max_ - len)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n <= capacity() - len &&
+        static_cast<std::size_t>(in_ - begin_) > len)
+    {
+        // More bytes were consumed than remain, so moving
+        // the input sequence costs less than those reads.
+        if(len > 0)
+            std::memmove(begin_, in_, len);
+        in_ = begin_;
+        out_ = in_ + len;
+    }
+    else
+    {
+        // Grow geometrically, up to the maximum size
+        auto const cap = capacity();
+        realloc(std::max(len + n,
+            cap > max_ / 2 ? max_ : cap * 2));
+    }
+    last_ = out_ + n;
+    return {out_, n};
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n < size())
+    {
+        in_ += n;
+        return;
+    }
+    if(last_ == out_)
+    {
+        // Both sequences are empty, start over at the front
+        in_ = begin_;
+        out_ = begin_;
+        last_ = begin_;
+    }
+    else
+    {
+        in_ = out_;
+    }
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+reserve(std::size_t n)
+{
+    if(n > max_)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n > capacity())
+        realloc(n);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+shrink_to_fit()
+{
+    auto const len = size();
+    if(len == capacity())
+        return;
+    if(len > 0)
+    {
+        realloc(len);
+        return;
+    }
+    clear();
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+realloc(std::size_t n)
+{
+    auto const len = size();
+    auto const p = alloc_traits::allocate(this->member(), n);
+    if(begin_)
+    {
+        if(len > 0)
+            std::memcpy(p, in_, len);
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+    }
+    begin_ = p;
+    in_ = begin_;
+    out_ = in_ + len;
+    last_ = out_;
+    end_ = begin_ + n;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_from(basic_flat_streambuf const& other)
+{
+    auto const len = other.size();
+    if(len > capacity())
+        realloc(len);
+    if(len > 0)
+        std::memcpy(in_, other.in_, len);
+    out_ = in_ + len;
+    last_ = out_;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_from(basic_flat_streambuf& other)
+{
+    begin_ = other.begin_;
+    in_ = other.in_;
+    out_ = other.out_;
+    last_ = out_;
+    end_ = other.end_;
+    other.begin_ = nullptr;
+    other.in_ = nullptr;
+    other.out_ = nullptr;
+    other.last_ = nullptr;
+    other.end_ = nullptr;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::false_type)
+{
+    if(this->member() != other.member())
+    {
+        copy_from(other);
+        other.clear();
+    }
+    else
+        move_assign(other, std::true_type{});
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::true_type)
+{
+    this->member() = std::move(other.member());
+    move_from(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::false_type)
+{
+    max_ = other.max_;
+    in_ = begin_;
+    out_ = begin_;
+    last_ = begin_;
+    copy_from(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::true_type)
+{
+    // The storage must be freed by the allocator which made it
+    if(this->member() != other.member())
+        clear();
+    this->member() = other.member();
+    copy_assign(other, std::false_type{});
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+clear()
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+    begin_ = nullptr;
+    in_ = nullptr;
+    out_ = nullptr;
+    last_ = nullptr;
+    end_ = nullptr;
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_flat_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    auto const size = streambuf.size();
+    return std::min<std::size_t>({max_size,
+        std::max<std::size_t>(512, streambuf.capacity() - size),
+            streambuf.max_ - size});
+}
+
+} // beast
+
+#endif
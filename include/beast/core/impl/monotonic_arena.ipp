@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_MONOTONIC_ARENA_IPP
+#define BEAST_IMPL_MONOTONIC_ARENA_IPP
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace beast {
+
+inline
+monotonic_arena::~monotonic_arena()
+{
+    while(list_)
+    {
+        auto const next = list_->next;
+        ::operator delete(list_);
+        list_ = next;
+    }
+}
+
+inline
+monotonic_arena::monotonic_arena(std::size_t chunk_size)
+    : chunk_size_(std::max(chunk_size, header_size + alignment))
+{
+}
+
+inline
+void*
+monotonic_arena::allocate(std::size_t n)
+{
+    auto const size = round_up(std::max<std::size_t>(n, 1));
+    if(static_cast<std::size_t>(end_ - next_) < size)
+        return allocate_slow(size);
+    auto const p = next_;
+    next_ += size;
+    return p;
+}
+
+inline
+void
+monotonic_arena::deallocate(void* p, std::size_t n)
+{
+    auto const size = round_up(std::max<std::size_t>(n, 1));
+    if(static_cast<char*>(p) + size == next_)
+        next_ = static_cast<char*>(p);
+}
+
+inline
+void
+monotonic_arena::clear()
+{
+    chunk* keep = nullptr;
+    for(auto c = list_; c;)
+    {
+        auto const next = c->next;
+        if(c->size <= max_chunk_size &&
+                (! keep || c->size > keep->size))
+            std::swap(keep, c);
+        if(c)
+            ::operator delete(c);
+        c = next;
+    }
+    if(keep)
+    {
+        keep->next = nullptr;
+        list_ = keep;
+        next_ = reinterpret_cast<char*>(keep) + header_size;
+        end_ = reinterpret_cast<char*>(keep) + keep->size;
+    }
+    else
+    {
+        next_ = nullptr;
+        end_ = nullptr;
+    }
+}
+
+inline
+void*
+monotonic_arena::allocate_slow(std::size_t size)
+{
+    auto const large = header_size + size > chunk_size_;
+    auto const chunk_size = large ?
+        header_size + size : chunk_size_;
+    auto const c = static_cast<chunk*>(
+        ::operator new(chunk_size));
+    c->next = list_;
+    c->size = chunk_size;
+    list_ = c;
+    auto const p = reinterpret_cast<char*>(c) + header_size;
+    if(large)
+        // The current chunk stays in use
+        return p;
+    // The rest of the current chunk is abandoned
+    next_ = p + size;
+    end_ = reinterpret_cast<char*>(c) + chunk_size;
+    if(chunk_size_ < max_chunk_size / 2)
+        chunk_size_ *= 2;
+    else
+        chunk_size_ = max_chunk_size;
+    return p;
+}
+
+} // beast
+
+#endif
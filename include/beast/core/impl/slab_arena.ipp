@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_SLAB_ARENA_IPP
+#define BEAST_IMPL_SLAB_ARENA_IPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+
+namespace beast {
+
+inline
+slab_arena::~slab_arena()
+{
+    for(auto list : {&chunks_, &large_})
+    {
+        auto n = list->next;
+        while(n != list)
+        {
+            auto const next = n->next;
+            ::operator delete(n);
+            n = next;
+        }
+    }
+}
+
+inline
+slab_arena::slab_arena(std::size_t chunk_size)
+    : chunk_size_(chunk_size)
+{
+    chunks_.prev = &chunks_;
+    chunks_.next = &chunks_;
+    large_.prev = &large_;
+    large_.next = &large_;
+}
+
+inline
+void*
+slab_arena::allocate(std::size_t n)
+{
+    if(n > detail::slab_sizes::max_size)
+    {
+        auto const p = static_cast<char*>(
+            ::operator new(header_size + n));
+        link(large_, *reinterpret_cast<node*>(p));
+        return p + header_size;
+    }
+    auto const i = detail::slab_sizes::index(n);
+    if(auto const b = free_[i])
+    {
+        free_[i] = b->next;
+        return b;
+    }
+    return allocate_slow(i);
+}
+
+inline
+void
+slab_arena::deallocate(void* p, std::size_t n)
+{
+    if(n > detail::slab_sizes::max_size)
+    {
+        auto const h = reinterpret_cast<node*>(
+            static_cast<char*>(p) - header_size);
+        unlink(*h);
+        ::operator delete(h);
+        return;
+    }
+    auto const i = detail::slab_sizes::index(n);
+    auto const b = static_cast<block*>(p);
+    b->next = free_[i];
+    free_[i] = b;
+}
+
+inline
+void*
+slab_arena::allocate_slow(std::size_t i)
+{
+    auto const size = detail::slab_sizes::size(i);
+    if(static_cast<std::size_t>(end_ - next_) < size)
+    {
+        // The rest of the current chunk is abandoned
+        auto const chunk_size = std::max(
+            chunk_size_, header_size + size);
+        auto const p = static_cast<char*>(
+            ::operator new(chunk_size));
+        link(chunks_, *reinterpret_cast<node*>(p));
+        next_ = p + header_size;
+        end_ = p + chunk_size;
+        chunk_size_ = std::min<std::size_t>(
+            2 * chunk_size_, 65536);
+    }
+    auto const p = next_;
+    next_ += size;
+    return p;
+}
+
+inline
+void
+slab_arena::link(node& list, node& n)
+{
+    n.prev = &list;
+    n.next = list.next;
+    list.next->prev = &n;
+    list.next = &n;
+}
+
+inline
+void
+slab_arena::unlink(node& n)
+{
+    n.prev->next = n.next;
+    n.next->prev = n.prev;
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_STATIC_BUFFER_LIST_IPP
+#define BEAST_IMPL_STATIC_BUFFER_LIST_IPP
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace beast {
+
+template<std::size_t N>
+template<class ConstBufferSequence>
+static_buffer_list<N>::
+static_buffer_list(ConstBufferSequence const& buffers)
+{
+    if(! append(buffers))
+        throw std::length_error{
+            "static_buffer_list overflow"};
+}
+
+template<std::size_t N>
+template<class ConstBufferSequence>
+bool
+static_buffer_list<N>::
+append(ConstBufferSequence const& buffers)
+{
+    static_assert(is_ConstBufferSequence<ConstBufferSequence>::value,
+        "ConstBufferSequence requirements not met");
+    using boost::asio::buffer_size;
+    if(begin_ > 0)
+    {
+        std::copy(v_.begin() + begin_,
+            v_.begin() + end_, v_.begin());
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    auto const end = end_;
+    for(auto it = buffers.begin(); it != buffers.end(); ++it)
+    {
+        boost::asio::const_buffer const b = *it;
+        if(buffer_size(b) == 0)
+            continue;
+        if(end_ == N)
+        {
+            end_ = end;
+            return false;
+        }
+        v_[end_++] = b;
+    }
+    return true;
+}
+
+template<std::size_t N>
+void
+static_buffer_list<N>::
+consume(std::size_t n)
+{
+    using boost::asio::buffer_size;
+    while(n > 0 && begin_ != end_)
+    {
+        auto& b = v_[begin_];
+        auto const len = buffer_size(b);
+        if(n < len)
+        {
+            b = b + n;
+            return;
+        }
+        n -= len;
+        ++begin_;
+    }
+    if(begin_ == end_)
+        clear();
+}
+
+template<std::size_t N>
+void
+static_buffer_list<N>::
+prepare(std::size_t n)
+{
+    using boost::asio::buffer_cast;
+    using boost::asio::buffer_size;
+    for(auto i = begin_; i != end_; ++i)
+    {
+        auto& b = v_[i];
+        auto const len = buffer_size(b);
+        if(n <= len)
+        {
+            if(n == 0)
+            {
+                end_ = i;
+                if(begin_ == end_)
+                    clear();
+                return;
+            }
+            b = boost::asio::const_buffer{
+                buffer_cast<void const*>(b), n};
+            end_ = i + 1;
+            return;
+        }
+        n -= len;
+    }
+}
+
+} // beast
+
+#endif
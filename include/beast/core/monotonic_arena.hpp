@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_MONOTONIC_ARENA_HPP
+#define BEAST_MONOTONIC_ARENA_HPP
+
+#include <beast/core/arena_allocator.hpp>
+#include <cstddef>
+
+namespace beast {
+
+/** An arena which hands out memory in order and frees it at once.
+
+    Each allocation takes the next bytes of the current chunk. A
+    deallocation does nothing, except that freeing the most recent
+    allocation returns its bytes to the chunk. The memory is
+    reclaimed all at once by @ref clear or by the destructor.
+
+    This suits objects with a common, short lifetime such as a
+    parsed HTTP request: the fields and body of a message are
+    allocated as it is read, and clearing the arena once the message
+    is destroyed releases all of them in constant time. A message
+    using the arena is declared as follows:
+
+    @code
+    using alloc_type = arena_allocator<char, monotonic_arena>;
+    using request_type = request_v1<
+        basic_string_body<alloc_type>, basic_headers<alloc_type>>;
+
+    monotonic_arena arena;
+    request_type req(std::piecewise_construct,
+        std::make_tuple(alloc_type(arena)),
+        std::make_tuple(alloc_type(arena)));
+    @endcode
+
+    The arena is not thread-safe.
+
+    @note Objects using memory from the arena must be destroyed
+    before the arena is cleared or destroyed.
+*/
+class monotonic_arena
+{
+    // Links the chunks owned by the arena
+    struct chunk
+    {
+        chunk* next;
+        std::size_t size;
+    };
+
+    static std::size_t constexpr max_chunk_size = 65536;
+
+    chunk* list_ = nullptr;
+    char* next_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t chunk_size_;
+
+public:
+    /// The alignment of every block returned by the arena.
+    static std::size_t constexpr alignment = 16;
+
+    /// Destructor. All memory allocated from the arena is released.
+    ~monotonic_arena();
+
+    monotonic_arena(monotonic_arena const&) = delete;
+    monotonic_arena& operator=(monotonic_arena const&) = delete;
+
+    /** Construct an arena.
+
+        No memory is allocated until the first allocation.
+
+        @param chunk_size The size of the first chunk. Each later
+        chunk is twice as large as the one before, up to 64KB.
+        Requests larger than the chunk size get a chunk of their own.
+    */
+    explicit
+    monotonic_arena(std::size_t chunk_size = 4096);
+
+    /// Allocate `n` bytes, aligned for any type of up to 16 bytes.
+    void*
+    allocate(std::size_t n);
+
+    /** Deallocate `n` bytes previously allocated from this arena.
+
+        The memory is only reused if it was the most recent
+        allocation; otherwise it is held until the arena is cleared.
+    */
+    void
+    deallocate(void* p, std::size_t n);
+
+    /** Release all memory allocated from the arena.
+
+        The largest chunk of up to 64KB is kept for the next
+        allocations, so an arena cleared after each message
+        reaches a steady state with no calls to the heap.
+    */
+    void
+    clear();
+
+private:
+    static
+    std::size_t
+    round_up(std::size_t n)
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    static std::size_t constexpr header_size =
+        (sizeof(chunk) + alignment - 1) & ~(alignment - 1);
+
+    void*
+    allocate_slow(std::size_t n);
+};
+
+} // beast
+
+#include <beast/core/impl/monotonic_arena.ipp>
+
+#endif
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_RECYCLING_ALLOCATOR_HPP
+#define BEAST_RECYCLING_ALLOCATOR_HPP
+
+#include <beast/core/detail/recycling_cache.hpp>
+#include <beast/core/detail/recycling_handler.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+
+/** An allocator which recycles recently freed blocks.
+
+    Each thread keeps at most one freed block of each size class,
+    with sizes rounded up to a power of two from 64 to 16KB. A
+    request is served from the cached block of its class when there
+    is one, otherwise from global `operator new`. Requests larger
+    than 16KB always use `operator new`.
+
+    The allocator is meant for short-lived objects which are freed
+    and allocated again in turn, such as the state of composed
+    operations. It is stateless, and memory may be freed on a
+    different thread from the one which allocated it.
+
+    @tparam T The type of objects allocated by the allocator.
+*/
+template<class T>
+class recycling_allocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = recycling_allocator<U>;
+    };
+
+    /// Default constructor.
+    recycling_allocator() = default;
+
+    /// Copy constructor.
+    recycling_allocator(recycling_allocator const&) = default;
+
+    /// Copy assignment.
+    recycling_allocator& operator=(recycling_allocator const&) = default;
+
+    /// Construct from an allocator for another type.
+    template<class U>
+    recycling_allocator(recycling_allocator<U> const&)
+    {
+    }
+
+    /// Allocate storage for `n` objects.
+    value_type*
+    allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+            "The type is over-aligned for recycling_allocator");
+        return static_cast<value_type*>(
+            detail::recycling_cache::allocate(n * sizeof(T)));
+    }
+
+    /// Deallocate storage for `n` objects.
+    void
+    deallocate(value_type* p, std::size_t n)
+    {
+        detail::recycling_cache::deallocate(p, n * sizeof(T));
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(recycling_allocator const&,
+        recycling_allocator<U> const&)
+    {
+        return true;
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(recycling_allocator const& lhs,
+        recycling_allocator<U> const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/** Attach the recycling allocator to a completion handler.
+
+    This function returns a new handler which, when invoked,
+    calls the original handler with the same arguments. The
+    returned handler implements `asio_handler_allocate` and
+    `asio_handler_deallocate` using the per-thread cache of
+    @ref recycling_allocator, so the memory for a chain of
+    asynchronous operations is reused from one step to the next
+    instead of coming from global `operator new` each time.
+    The continuation and invocation hooks of the original handler
+    are preserved, so a handler wrapped by a strand may be passed.
+
+    Example:
+    @code
+    async_read(sock, sb, req, bind_recycling_allocator(
+        [&](error_code const& ec)
+        {
+            // ...
+        }));
+    @endcode
+
+    @param handler The handler to wrap. It is moved or copied
+    into the returned handler.
+*/
+template<class CompletionHandler>
+#if GENERATING_DOCS
+implementation_defined
+#else
+detail::recycling_handler<
+    typename std::decay<CompletionHandler>::type>
+#endif
+bind_recycling_allocator(CompletionHandler&& handler)
+{
+    static_assert(std::is_copy_constructible<
+        typename std::decay<CompletionHandler>::type>::value,
+            "CompletionHandler requirements not met");
+    return detail::recycling_handler<typename std::decay<
+        CompletionHandler>::type>(std::forward<
+            CompletionHandler>(handler));
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_SLAB_ALLOCATOR_HPP
+#define BEAST_SLAB_ALLOCATOR_HPP
+
+#include <beast/core/detail/slab_cache.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace beast {
+
+/** An allocator using thread-local caches of size-classed blocks.
+
+    Requests of up to 16KB are rounded up to one of a set of size
+    classes and served from a cache belonging to the calling thread,
+    without taking a lock. Blocks freed on the thread which allocated
+    them are reused immediately. Blocks freed on another thread are
+    handed back to the owning cache without a lock, and reused once
+    that cache runs out of blocks of the same class. Larger requests
+    go to `::operator new`.
+
+    This suits the allocation patterns of @ref basic_streambuf and
+    @ref http::basic_headers, which request many blocks of a few
+    sizes, often from several threads running the same `io_service`.
+
+    Memory held by the caches is kept for reuse, and returned to
+    the system when the program exits. The caches of threads which
+    exit are adopted by threads created later.
+
+    The allocator holds no state; all instances compare equal.
+
+    @tparam T The type of objects allocated by the allocator.
+*/
+template<class T>
+class slab_allocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = slab_allocator<U>;
+    };
+
+    /// Default constructor.
+    slab_allocator() = default;
+
+    /// Copy constructor.
+    slab_allocator(slab_allocator const&) = default;
+
+    /// Copy assignment.
+    slab_allocator& operator=(slab_allocator const&) = default;
+
+    /// Construct from an allocator for another type.
+    template<class U>
+    slab_allocator(slab_allocator<U> const&)
+    {
+    }
+
+    /// Allocate storage for `n` objects.
+    value_type*
+    allocate(std::size_t n)
+    {
+        auto const size = n * sizeof(T);
+        if(size > detail::slab_sizes::max_size ||
+                alignof(T) > detail::slab_sizes::align)
+            return static_cast<value_type*>(
+                ::operator new(size));
+        return static_cast<value_type*>(
+            detail::slab_cache::local().allocate(size));
+    }
+
+    /// Deallocate storage for `n` objects.
+    void
+    deallocate(value_type* p, std::size_t n)
+    {
+        auto const size = n * sizeof(T);
+        if(size > detail::slab_sizes::max_size ||
+                alignof(T) > detail::slab_sizes::align)
+            return ::operator delete(p);
+        detail::slab_cache::deallocate(p);
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(slab_allocator const&,
+        slab_allocator<U> const&)
+    {
+        return true;
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(slab_allocator const&,
+        slab_allocator<U> const&)
+    {
+        return false;
+    }
+};
+
+} // beast
+
+#endif
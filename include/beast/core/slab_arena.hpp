@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_SLAB_ARENA_HPP
+#define BEAST_SLAB_ARENA_HPP
+
+#include <beast/core/arena_allocator.hpp>
+#include <beast/core/detail/slab_cache.hpp>
+#include <cstddef>
+
+namespace beast {
+
+/** A pool of size-classed memory blocks which is released at once.
+
+    Requests of up to 16KB are rounded up to one of a set of size
+    classes and carved from chunks owned by the arena. Freed blocks
+    are kept on a list for their class and reused by later requests
+    of the same class. Larger requests are allocated individually.
+    When the arena is destroyed all of its memory is released, with
+    one deallocation per chunk rather than one per block.
+
+    An arena is meant to belong to one connection, and to supply
+    the memory for the containers of that connection through
+    @ref arena_allocator. It is not thread-safe; a connection using
+    more than one thread must serialize its operations, for example
+    with a strand.
+
+    @note Objects using memory from the arena must not be used
+    after the arena is destroyed.
+*/
+class slab_arena
+{
+    struct block
+    {
+        block* next;
+    };
+
+    // Links a chunk, or a large allocation, to the arena
+    struct node
+    {
+        node* prev;
+        node* next;
+    };
+
+    static std::size_t constexpr header_size =
+        (sizeof(node) + detail::slab_sizes::align - 1) &
+            ~(detail::slab_sizes::align - 1);
+
+    block* free_[detail::slab_sizes::count] = {};
+    node chunks_;
+    node large_;
+    char* next_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t chunk_size_;
+
+public:
+    /// The alignment of every block returned by the arena.
+    static std::size_t constexpr alignment =
+        detail::slab_sizes::align;
+
+    /// Destructor. All memory allocated from the arena is released.
+    ~slab_arena();
+
+    slab_arena(slab_arena const&) = delete;
+    slab_arena& operator=(slab_arena const&) = delete;
+
+    /** Construct an arena.
+
+        No memory is allocated until the first allocation.
+
+        @param chunk_size The size of the first chunk. Each later
+        chunk is twice as large as the one before, up to 64KB.
+    */
+    explicit
+    slab_arena(std::size_t chunk_size = 4096);
+
+    /// Allocate `n` bytes, aligned for any type of up to 16 bytes.
+    void*
+    allocate(std::size_t n);
+
+    /// Deallocate `n` bytes previously allocated from this arena.
+    void
+    deallocate(void* p, std::size_t n);
+
+private:
+    void*
+    allocate_slow(std::size_t i);
+
+    static
+    void
+    link(node& list, node& n);
+
+    static
+    void
+    unlink(node& n);
+};
+
+} // beast
+
+#include <beast/core/impl/slab_arena.ipp>
+
+#endif
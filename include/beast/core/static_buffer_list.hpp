@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_STATIC_BUFFER_LIST_HPP
+#define BEAST_STATIC_BUFFER_LIST_HPP
+
+#include <beast/core/buffer_concepts.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
+
+namespace beast {
+
+/** A @b `ConstBufferSequence` held in a fixed size array.
+
+    The list stores up to `N` buffers in place. Its iterators are
+    plain pointers to `boost::asio::const_buffer`, so a stream
+    converts it to the scatter/gather array of the operating system
+    without going through any iterator adapters. Bytes are removed
+    from the front with @ref consume, and the list is limited to a
+    leading number of bytes with @ref prepare, both without copying
+    the list.
+
+    Buffer sequences produced by the serializers, such as the
+    concatenations returned by @ref buffer_cat, are flattened into
+    the list with @ref append.
+
+    Example:
+    @code
+    template<class SyncWriteStream, class ConstBufferSequence>
+    void
+    write_all(SyncWriteStream& stream, ConstBufferSequence const& buffers)
+    {
+        static_buffer_list<64> bl(buffers);
+        while(! bl.empty())
+            bl.consume(stream.write_some(bl));
+    }
+    @endcode
+
+    @note Empty buffers are never stored in the list.
+
+    @tparam N The largest number of buffers the list can hold.
+*/
+template<std::size_t N>
+class static_buffer_list
+{
+    std::array<boost::asio::const_buffer, N> v_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+
+public:
+    /// The type for each element in the list of buffers.
+    using value_type = boost::asio::const_buffer;
+
+    /// A random access iterator type that may be used to read elements.
+    using const_iterator = value_type const*;
+
+    /// Default constructor. The list is empty.
+    static_buffer_list() = default;
+
+    /// Copy constructor.
+    static_buffer_list(static_buffer_list const&) = default;
+
+    /// Copy assignment.
+    static_buffer_list& operator=(static_buffer_list const&) = default;
+
+    /** Construct a list from a buffer sequence.
+
+        @throws std::length_error if the sequence holds more
+        than `N` non-empty buffers.
+    */
+    template<class ConstBufferSequence>
+    explicit
+    static_buffer_list(ConstBufferSequence const& buffers);
+
+    /// Get a random access iterator to the first element.
+    const_iterator
+    begin() const
+    {
+        return v_.data() + begin_;
+    }
+
+    /// Get a random access iterator for one past the last element.
+    const_iterator
+    end() const
+    {
+        return v_.data() + end_;
+    }
+
+    /// Returns `true` if the list holds no bytes.
+    bool
+    empty() const
+    {
+        return begin_ == end_;
+    }
+
+    /// Returns the largest number of buffers the list can hold.
+    static
+    std::size_t constexpr
+    capacity()
+    {
+        return N;
+    }
+
+    /// Remove all buffers from the list.
+    void
+    clear()
+    {
+        begin_ = 0;
+        end_ = 0;
+    }
+
+    /** Append the buffers of a sequence to the end of the list.
+
+        @return `true` on success. If the list does not have room
+        for the non-empty buffers of the sequence, `false` is
+        returned and the list is unchanged.
+    */
+    template<class ConstBufferSequence>
+    bool
+    append(ConstBufferSequence const& buffers);
+
+    /** Remove bytes from the beginning of the list.
+
+        @param n The number of bytes to remove. If this is
+        larger than the number of bytes remaining, all the
+        bytes remaining are removed.
+    */
+    void
+    consume(std::size_t n);
+
+    /** Limit the list to its first bytes.
+
+        The bytes after the first `n` bytes are removed from
+        the list.
+
+        @param n The number of bytes to keep. If this is larger
+        than the number of bytes in the list, the list is unchanged.
+    */
+    void
+    prepare(std::size_t n);
+};
+
+} // beast
+
+#include <beast/core/impl/static_buffer_list.ipp>
+
+#endif
@@ -31,13 +31,18 @@ namespace beast {
 
     @li A type meeting the requirements of @b `MutableBufferSequence`
 
+    @li An integer or floating point type
+
+    Numbers are formatted directly into the dynamic buffer without
+    allocating memory. Integers are written in decimal. Floating point
+    values are written with enough digits to preserve the value, as
+    if by a stream with the precision set to `max_digits10`, and always
+    use '.' as the decimal point regardless of the locale.
+
     For all types not listed above, the function will invoke
     `boost::lexical_cast` on the argument in an attempt to convert to
     a string, which is then appended to the dynamic buffer.
 
-    When this function serializes numbers, it converts them to
-    their text representation as if by a call to `std::to_string`.
-
     @param dynabuf The dynamic buffer to write to.
 
     @param args A list of one or more arguments to write.
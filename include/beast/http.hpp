@@ -10,11 +10,15 @@
 
 #include <beast/http/basic_headers.hpp>
 #include <beast/http/basic_parser_v1.hpp>
+#include <beast/http/basic_string_body.hpp>
 #include <beast/http/body_type.hpp>
 #include <beast/http/empty_body.hpp>
+#include <beast/http/file_body.hpp>
+#include <beast/http/header_parser_v1.hpp>
 #include <beast/http/headers.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/message_v1.hpp>
+#include <beast/http/mmap_body.hpp>
 #include <beast/http/parse_error.hpp>
 #include <beast/http/parser_v1.hpp>
 #include <beast/http/read.hpp>
@@ -24,6 +24,14 @@ struct basic_dynabuf_body
     /// The type of the `message::body` member
     using value_type = DynamicBuffer;
 
+    /// Returns the number of octets in the body.
+    static
+    std::uint64_t
+    size(value_type const& body, error_code&)
+    {
+        return body.size();
+    }
+
 #if GENERATING_DOCS
 private:
 #endif
@@ -50,6 +58,18 @@ private:
             sb_.commit(buffer_copy(
                 sb_.prepare(size), buffer(data, size)));
         }
+
+        typename DynamicBuffer::mutable_buffers_type
+        prepare(std::size_t size)
+        {
+            return sb_.prepare(size);
+        }
+
+        void
+        commit(std::size_t size)
+        {
+            sb_.commit(size);
+        }
     };
 
     class writer
@@ -80,10 +100,10 @@ private:
         }
 
         template<class Write>
-        boost::tribool
+        bool
         operator()(resume_context&&, error_code&, Write&& write)
         {
-            write(body_.data());
+            write(body_.data(), true);
             return true;
         }
     };
@@ -16,6 +16,8 @@
 #include <boost/utility/string_ref.hpp>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -31,18 +33,20 @@ namespace detail {
 
 class basic_headers_base
 {
+protected:
+    struct element;
+
 public:
+    /*  A field in the container.
+
+        The name and value refer to storage owned by the container,
+        and remain valid until the field is erased or the container
+        is destroyed. Only the container creates fields.
+    */
     struct value_type
     {
-        std::string first;
-        std::string second;
-
-        value_type(boost::string_ref const& name_,
-                boost::string_ref const& value_)
-            : first(name_)
-            , second(value_)
-        {
-        }
+        boost::string_ref first;
+        boost::string_ref second;
 
         boost::string_ref
         name() const
@@ -55,12 +59,24 @@ public:
         {
             return second;
         }
+
+    private:
+        friend struct basic_headers_base::element;
+
+        value_type(boost::string_ref const& name_,
+                boost::string_ref const& value_)
+            : first(name_)
+            , second(value_)
+        {
+        }
     };
 
 protected:
     template<class Allocator>
     friend class beast::http::basic_headers;
 
+    // The name and value are stored after the element,
+    // so each field takes a single allocation.
     struct element
         : boost::intrusive::set_base_hook <
             boost::intrusive::link_mode <
@@ -73,8 +89,33 @@ protected:
 
         element(boost::string_ref const& name,
                 boost::string_ref const& value)
-            : data(name, value)
+            : data(copy(name, 0), copy(value, name.size()))
+        {
+        }
+
+        // Returns the number of bytes to allocate
+        static
+        std::size_t
+        size(boost::string_ref const& name,
+            boost::string_ref const& value)
+        {
+            return sizeof(element) + name.size() + value.size();
+        }
+
+        std::size_t
+        size() const
+        {
+            return size(data.first, data.second);
+        }
+
+    private:
+        boost::string_ref
+        copy(boost::string_ref const& s, std::size_t offset)
         {
+            auto const p = reinterpret_cast<char*>(this + 1) + offset;
+            if(! s.empty())
+                std::memcpy(p, s.data(), s.size());
+            return {p, s.size()};
         }
     };
 
@@ -248,6 +289,12 @@ public:
     as a std::multiset; there will be a separate value for each occurrence
     of the field name.
 
+    Each field is stored in a single allocation. The `first` and `second`
+    members of an iterated field, equal to `name()` and `value()`, are
+    `boost::string_ref` objects referring to that storage. They remain
+    valid until the field is erased or the container is destroyed; use
+    `to_string()` on them to keep a copy.
+
     @note Meets the requirements of @b `FieldSequence`.
 */
 template<class Allocator>
@@ -255,15 +302,13 @@ class basic_headers
 #if ! GENERATING_DOCS
     : private beast::detail::empty_base_optimization<
         typename std::allocator_traits<Allocator>::
-            template rebind_alloc<
-                detail::basic_headers_base::element>>
+            template rebind_alloc<std::uint8_t>>
     , public detail::basic_headers_base
 #endif
 {
     using alloc_type = typename
         std::allocator_traits<Allocator>::
-            template rebind_alloc<
-                detail::basic_headers_base::element>;
+            template rebind_alloc<std::uint8_t>;
 
     using alloc_traits =
         std::allocator_traits<alloc_type>;
@@ -271,6 +316,13 @@ class basic_headers
     using size_type =
         typename std::allocator_traits<Allocator>::size_type;
 
+    element&
+    new_element(boost::string_ref const& name,
+        boost::string_ref const& value);
+
+    void
+    delete_element(element& e);
+
     void
     delete_all();
 
@@ -345,6 +397,13 @@ public:
     template<class FwdIt>
     basic_headers(FwdIt first, FwdIt last);
 
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
     /// Returns `true` if the field sequence contains no elements.
     bool
     empty() const
@@ -17,6 +17,7 @@
 #include <array>
 #include <climits>
 #include <cstdint>
+#include <string>
 #include <type_traits>
 
 namespace beast {
@@ -87,9 +88,10 @@ static std::uint64_t constexpr no_content_length =
 /** A parser for decoding HTTP/1 wire format messages.
 
     This parser is designed to efficiently parse messages in the
-    HTTP/1 wire format. It allocates no memory and uses minimal
-    state. It will handle chunked encoding and it understands the
-    semantics of the Connection and Content-Length header fields.
+    HTTP/1 wire format. It uses minimal state, and allocates memory
+    only to hold chunk extensions which span calls to `write`. It
+    will handle chunked encoding and it understands the semantics
+    of the Connection and Content-Length header fields.
 
     The interface uses CRTP (Curiously Recurring Template Pattern).
     To use this class, derive from basic_parser. When bytes are
@@ -141,7 +143,22 @@ static std::uint64_t constexpr no_content_length =
 
         Called for each piece of the body. If the headers indicated
         chunked encoding, the chunk encoding is removed from the
-        buffer before being passed to the callback.
+        buffer before being passed to the callback. The payload of
+        each chunk is passed in place, as a single piece when it lies
+        in one input buffer.
+
+    @li `void on_chunk_header(std::uint64_t size, boost::string_ref const& extensions, error_code&)`
+
+        Called for each chunk header in a chunked body, including
+        the final chunk of size zero. The string contains the chunk
+        extensions exactly as they appear on the wire following the
+        chunk size, or is empty if there are none. It may be
+        iterated with @ref param_list. Extensions are limited in size
+        by the headers maximum size option.
+
+        Trailer fields following the final chunk are delivered
+        through `on_field` and `on_value` in the same manner as the
+        headers, and `on_headers` is not called for them.
 
     @li `void on_complete(error_code&)`
 
@@ -161,11 +178,22 @@ static std::uint64_t constexpr no_content_length =
     @li *2* The parser should skip ths body, this is an
         upgrade to a different protocol.
 
+    @li *3* The parser should expect a body, but return control to
+        the caller after the headers. The call to `write` which
+        completes the headers returns, and @ref paused returns `true`.
+        The body is parsed by subsequent calls to `write`. This allows
+        the caller to inspect the headers before deciding how the body
+        is processed. If the message has no body, it is completed
+        normally instead of pausing.
+
     The parser uses traits to determine if the callback is possible.
     If the Derived type omits one or more callbacks, they are simply
     skipped with no compilation error. The default behavior of `on_body`
     when the derived class does not provide the member, is to specify that
-    the body should not be skipped.
+    the body should not be skipped. The bookkeeping for an omitted
+    callback is removed at compile time, so a derived class which only
+    needs a subset of the message (for example, just the method and URI)
+    does not pay for the pieces it ignores.
 
     If a callback sets an error, parsing stops at the current octet
     and the error is returned to the caller.
@@ -225,6 +253,7 @@ private:
     std::size_t b_left_;
     std::uint64_t content_length_;
     pmf_t cb_;
+    std::string ext_;
     state s_              : 8;
     unsigned flags_       : 8;
     unsigned fs_          : 8;
@@ -233,6 +262,10 @@ private:
     unsigned http_minor_  : 16;
     unsigned status_code_ : 16;
     bool upgrade_         : 1; // true if parser exited for upgrade
+    bool paused_          : 1; // true if parser paused after headers
+
+    template<bool, class>
+    friend class basic_parser_v1;
 
 public:
     /// Copy constructor.
@@ -343,6 +376,19 @@ public:
         return upgrade_;
     }
 
+    /** Returns `true` if the parser paused after the headers.
+
+        A value of `true` indicates that the derived class requested
+        a pause from `on_headers`, and that the headers are complete
+        but the body has not been parsed yet. The next call to `write`
+        resumes parsing with the body.
+    */
+    bool
+    paused() const
+    {
+        return paused_;
+    }
+
     /** Returns the numeric HTTP Status-Code of a response.
 
         @return The Status-Code.
@@ -376,6 +422,38 @@ public:
         return s_ == s_restart || s_ == s_closed_complete;
     }
 
+    /** Returns the number of body octets remaining in the message.
+
+        This returns a non-zero value only when the parser is
+        positioned in a body whose size is given by Content-Length,
+        in which case it is the number of body octets the parser
+        still expects. Otherwise, zero is returned.
+    */
+    std::uint64_t
+    body_remain() const
+    {
+        if(s_ != s_body_identity0 && s_ != s_body_identity)
+            return 0;
+        return content_length_;
+    }
+
+    /** Account for body octets stored directly by the caller.
+
+        This informs the parser that `n` octets of the body were
+        delivered to the body storage without being presented to
+        `write`, for example by reading from a stream directly into
+        the body. The `on_body` callback is not invoked for these
+        octets. When the last octet of the body is accounted for,
+        the message is completed and `on_complete` is invoked.
+
+        @param n The number of body octets, which must not exceed
+        the value returned by @ref body_remain.
+
+        @param ec Set to the error, if any error occurred.
+    */
+    void
+    consume_body(std::size_t n, error_code& ec);
+
     /** Write a sequence of buffers to the parser.
 
         @param buffers An object meeting the requirements of
@@ -418,6 +496,18 @@ public:
     void
     write_eof(error_code& ec);
 
+protected:
+    /** Construct from the state of another parser.
+
+        This is used to continue parsing a message with a different
+        derived class, for example one which was chosen after the
+        headers were received. Parsing resumes where `other` left off.
+    */
+    template<class OtherDerived>
+    explicit
+    basic_parser_v1(
+        basic_parser_v1<isRequest, OtherDerived> const& other);
+
 private:
     Derived&
     impl()
@@ -442,6 +532,7 @@ private:
     {
         h_left_ = h_max_;
         b_left_ = b_max_;
+        paused_ = false;
         reset(std::integral_constant<bool, isRequest>{});
     }
 
@@ -589,7 +680,7 @@ private:
     class has_on_field_t
     {
         template<class T, class R =
-            decltype(std::declval<T>().on_uri(
+            decltype(std::declval<T>().on_field(
                 std::declval<boost::string_ref const&>(),
                 std::declval<error_code&>()),
                     std::true_type{})>
@@ -608,7 +699,7 @@ private:
     class has_on_value_t
     {
         template<class T, class R =
-            decltype(std::declval<T>().on_uri(
+            decltype(std::declval<T>().on_value(
                 std::declval<boost::string_ref const&>(),
                 std::declval<error_code&>()),
                     std::true_type{})>
@@ -659,6 +750,26 @@ private:
     using has_on_body =
         std::integral_constant<bool, has_on_body_t<C>::value>;
 
+    template<class C>
+    class has_on_chunk_header_t
+    {
+        template<class T, class R =
+            decltype(std::declval<T>().on_chunk_header(
+                std::declval<std::uint64_t>(),
+                std::declval<boost::string_ref const&>(),
+                std::declval<error_code&>()),
+                    std::true_type{})>
+        static R check(int);
+        template<class>
+        static std::false_type check(...);
+        using type = decltype(check<C>(0));
+    public:
+        static bool const value = type::value;
+    };
+    template<class C>
+    using has_on_chunk_header =
+        std::integral_constant<bool, has_on_chunk_header_t<C>::value>;
+
     template<class C>
     class has_on_complete_t
     {
@@ -677,6 +788,36 @@ private:
     using has_on_complete =
         std::integral_constant<bool, has_on_complete_t<C>::value>;
 
+    // Compile-time policy flags computed from the callbacks
+    // provided by Derived. The state machine omits the piece
+    // tracking for any callback which is absent.
+    struct policy
+    {
+        static bool constexpr method =
+            isRequest && has_on_method<Derived>::value;
+
+        static bool constexpr uri =
+            isRequest && has_on_uri<Derived>::value;
+
+        static bool constexpr reason =
+            ! isRequest && has_on_reason<Derived>::value;
+
+        static bool constexpr field =
+            has_on_field<Derived>::value;
+
+        static bool constexpr value =
+            has_on_value<Derived>::value;
+
+        static bool constexpr body =
+            has_on_body<Derived>::value;
+
+        static bool constexpr chunk_header =
+            has_on_chunk_header<Derived>::value;
+
+        static bool constexpr any =
+            method || uri || reason || field || value || body;
+    };
+
     void call_on_start(error_code& ec, std::true_type)
     {
         impl().on_start(ec);
@@ -702,19 +843,10 @@ private:
     {
     }
 
-    void call_on_method(error_code& ec,
-        boost::string_ref const& s)
+    void call_on_method(error_code& ec, boost::string_ref const& s)
     {
-        if(! h_max_ || s.size() <= h_left_)
-        {
-            h_left_ -= s.size();
-            call_on_method(ec, s, std::integral_constant<bool,
-                isRequest && has_on_method<Derived>::value>{});
-        }
-        else
-        {
-            ec = parse_error::headers_too_big;
-        }
+        call_on_method(ec, s, std::integral_constant<bool,
+            isRequest && has_on_method<Derived>::value>{});
     }
 
     void call_on_uri(error_code& ec,
@@ -730,16 +862,8 @@ private:
 
     void call_on_uri(error_code& ec, boost::string_ref const& s)
     {
-        if(! h_max_ || s.size() <= h_left_)
-        {
-            h_left_ -= s.size();
-            call_on_uri(ec, s, std::integral_constant<bool,
-                isRequest && has_on_uri<Derived>::value>{});
-        }
-        else
-        {
-            ec = parse_error::headers_too_big;
-        }
+        call_on_uri(ec, s, std::integral_constant<bool,
+            isRequest && has_on_uri<Derived>::value>{});
     }
 
     void call_on_reason(error_code& ec,
@@ -755,16 +879,8 @@ private:
 
     void call_on_reason(error_code& ec, boost::string_ref const& s)
     {
-        if(! h_max_ || s.size() <= h_left_)
-        {
-            h_left_ -= s.size();
-            call_on_reason(ec, s, std::integral_constant<bool,
-                ! isRequest && has_on_reason<Derived>::value>{});
-        }
-        else
-        {
-            ec = parse_error::headers_too_big;
-        }
+        call_on_reason(ec, s, std::integral_constant<bool,
+            ! isRequest && has_on_reason<Derived>::value>{});
     }
 
     void call_on_request(error_code& ec, std::true_type)
@@ -810,15 +926,7 @@ private:
 
     void call_on_field(error_code& ec, boost::string_ref const& s)
     {
-        if(! h_max_ || s.size() <= h_left_)
-        {
-            h_left_ -= s.size();
-            call_on_field(ec, s, has_on_field<Derived>{});
-        }
-        else
-        {
-            ec = parse_error::headers_too_big;
-        }
+        call_on_field(ec, s, has_on_field<Derived>{});
     }
 
     void call_on_value(error_code& ec,
@@ -834,15 +942,7 @@ private:
 
     void call_on_value(error_code& ec, boost::string_ref const& s)
     {
-        if(! h_max_ || s.size() <= h_left_)
-        {
-            h_left_ -= s.size();
-            call_on_value(ec, s, has_on_value<Derived>{});
-        }
-        else
-        {
-            ec = parse_error::headers_too_big;
-        }
+        call_on_value(ec, s, has_on_value<Derived>{});
     }
 
     int call_on_headers(error_code& ec,
@@ -875,15 +975,25 @@ private:
 
     void call_on_body(error_code& ec, boost::string_ref const& s)
     {
-        if(! b_max_ || s.size() <= b_left_)
-        {
-            b_left_ -= s.size();
-            call_on_body(ec, s, has_on_body<Derived>{});
-        }
-        else
-        {
-            ec = parse_error::body_too_big;
-        }
+        call_on_body(ec, s, has_on_body<Derived>{});
+    }
+
+    void call_on_chunk_header(error_code& ec, std::uint64_t size,
+        boost::string_ref const& ext, std::true_type)
+    {
+        impl().on_chunk_header(size, ext, ec);
+    }
+
+    void call_on_chunk_header(error_code&, std::uint64_t,
+        boost::string_ref const&, std::false_type)
+    {
+    }
+
+    void call_on_chunk_header(error_code& ec,
+        std::uint64_t size, boost::string_ref const& ext)
+    {
+        call_on_chunk_header(ec, size, ext,
+            has_on_chunk_header<Derived>{});
     }
 
     void call_on_complete(error_code& ec, std::true_type)
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_BASIC_STRING_BODY_HPP
+#define BEAST_HTTP_BASIC_STRING_BODY_HPP
+
+#include <beast/http/body_type.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/** A Body represented by a `std::basic_string`.
+
+    The body memory comes from the allocator of the string. To
+    parse into a body using a stateful allocator, construct the
+    message with a body holding that allocator; @ref read and
+    @ref async_read use the allocators of the destination message.
+
+    Meets the requirements of @b `Body`.
+
+    @tparam Allocator The allocator used by the string.
+*/
+template<class Allocator>
+struct basic_string_body
+{
+    /// The type of the `message::body` member
+    using value_type = std::basic_string<
+        char, std::char_traits<char>, Allocator>;
+
+    /// Returns the number of octets in the body.
+    static
+    std::uint64_t
+    size(value_type const& body, error_code&)
+    {
+        return body.size();
+    }
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class reader
+    {
+        value_type& s_;
+        // Octets of the body stored in the string. Between calls
+        // to prepare and commit, the string may be longer.
+        std::size_t n_;
+
+    public:
+        template<bool isRequest, class Headers>
+        explicit
+        reader(message<isRequest,
+                basic_string_body, Headers>& m) noexcept
+            : s_(m.body)
+            , n_(m.body.size())
+        {
+        }
+
+        void
+        write(void const* data,
+            std::size_t size, error_code&) noexcept
+        {
+            if(s_.size() < n_ + size)
+                s_.resize(n_ + size);
+            std::memcpy(&s_[n_], data, size);
+            n_ += size;
+        }
+
+        // The string only grows. Octets prepared but not received
+        // are kept for the next call, so resize value-initializes
+        // each octet of the body at most once.
+        boost::asio::mutable_buffers_1
+        prepare(std::size_t size)
+        {
+            if(s_.size() < n_ + size)
+                s_.resize(n_ + size);
+            return {&s_[n_], size};
+        }
+
+        void
+        commit(std::size_t size) noexcept
+        {
+            n_ += size;
+            // Nothing was received, the read
+            // failed so drop the unused octets.
+            if(size == 0)
+                s_.resize(n_);
+        }
+    };
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        explicit
+        writer(message<isRequest,
+                basic_string_body, Headers> const& msg)
+            : body_(msg.body)
+        {
+        }
+
+        void
+        init(error_code& ec)
+        {
+        }
+
+        std::uint64_t
+        content_length() const
+        {
+            return body_.size();
+        }
+
+        template<class Write>
+        bool
+        operator()(resume_context&&, error_code&, Write&& write)
+        {
+            write(boost::asio::buffer(body_), true);
+            return true;
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
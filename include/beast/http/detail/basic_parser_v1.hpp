@@ -121,9 +121,14 @@ protected:
 
         s_chunk_size0,
         s_chunk_size,
+        s_chunk_ext_ws,
         s_chunk_ext_name0,
         s_chunk_ext_name,
+        s_chunk_ext_name_ws,
+        s_chunk_ext_val0,
         s_chunk_ext_val,
+        s_chunk_ext_val_quoted,
+        s_chunk_ext_val_escape,
         s_chunk_size_lf,
         s_chunk_data0,
         s_chunk_data,
@@ -100,8 +100,8 @@ template<class ConstBufferSequence>
 #if GENERATING_DOCS
 implementation_defined
 #else
-beast::detail::buffer_cat_helper<boost::asio::const_buffer,
-    chunk_encode_text, ConstBufferSequence, boost::asio::const_buffers_1>
+beast::detail::buffer_cat_t<chunk_encode_text,
+    ConstBufferSequence, boost::asio::const_buffers_1>
 #endif
 chunk_encode(ConstBufferSequence const& buffers)
 {
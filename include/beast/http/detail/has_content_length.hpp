@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_DETAIL_HAS_CONTENT_LENGTH_HPP
 #define BEAST_HTTP_DETAIL_HAS_CONTENT_LENGTH_HPP
 
+#include <beast/core/error.hpp>
 #include <cstdint>
 #include <type_traits>
 
@@ -36,6 +37,29 @@ using has_content_length =
     std::integral_constant<bool,
         has_content_length_value<T>::value>;
 
+template<class T>
+class has_size_value
+{
+    template<class U, class R = typename std::is_convertible<
+        decltype(U::size(
+            std::declval<typename U::value_type const&>(),
+                std::declval<error_code&>())),
+                    std::uint64_t>>
+    static R check(int);
+    template<class>
+    static std::false_type check(...);
+    using type = decltype(check<T>(0));
+public:
+    // `true` if `T` meets the requirements.
+    static bool const value = type::value;
+};
+
+// Determines if the body can provide its size without a writer
+template<class T>
+using has_size =
+    std::integral_constant<bool,
+        has_size_value<T>::value>;
+
 } // detail
 } // http
 } // beast
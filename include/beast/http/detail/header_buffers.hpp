@@ -0,0 +1,308 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_HEADER_BUFFERS_HPP
+#define BEAST_HTTP_DETAIL_HEADER_BUFFERS_HPP
+
+#include <beast/http/message_v1.hpp>
+#include <beast/core/detail/format_number.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  A ConstBufferSequence representing the start line of a message.
+
+    The method, URL and reason are referenced in place. Only the
+    version and status are formatted, into a small inline buffer.
+*/
+class start_line_buffers
+{
+    std::array<boost::asio::const_buffer, 4> b_;
+    std::size_t n_;
+    std::size_t i_;
+
+    // Storage for "HTTP/x.y ddddd " or " HTTP/x.y\r\n"
+    std::array<char, 32> buf_;
+
+    static
+    char*
+    append(char* p, char const* s)
+    {
+        while(*s)
+            *p++ = *s++;
+        return p;
+    }
+
+    static
+    char*
+    append(char* p, unsigned v)
+    {
+        char tmp[beast::detail::max_number_chars];
+        auto const end = std::end(tmp);
+        for(auto it = beast::detail::format_uint(end, v);
+                it != end;)
+            *p++ = *it++;
+        return p;
+    }
+
+    char*
+    append_version(char* p, int version)
+    {
+        p = append(p, "HTTP/");
+        p = append(p, static_cast<unsigned>(version / 10));
+        *p++ = '.';
+        return append(p, static_cast<unsigned>(version % 10));
+    }
+
+    boost::asio::const_buffer
+    formatted(char const* last) const
+    {
+        return {buf_.data(), static_cast<std::size_t>(
+            last - buf_.data())};
+    }
+
+public:
+    using value_type = boost::asio::const_buffer;
+
+    using const_iterator = value_type const*;
+
+    start_line_buffers(start_line_buffers const& other)
+        : b_(other.b_)
+        , n_(other.n_)
+        , i_(other.i_)
+        , buf_(other.buf_)
+    {
+        b_[i_] = boost::asio::const_buffer{buf_.data(),
+            boost::asio::buffer_size(other.b_[i_])};
+    }
+
+    template<class Body, class Headers>
+    explicit
+    start_line_buffers(
+        message_v1<true, Body, Headers> const& msg)
+    {
+        using boost::asio::buffer;
+        auto p = buf_.data();
+        *p++ = ' ';
+        p = append_version(p, msg.version);
+        p = append(p, "\r\n");
+        b_[0] = buffer(msg.method);
+        b_[1] = boost::asio::const_buffer{" ", 1};
+        b_[2] = buffer(msg.url);
+        b_[3] = formatted(p);
+        i_ = 3;
+        n_ = 4;
+    }
+
+    template<class Body, class Headers>
+    explicit
+    start_line_buffers(
+        message_v1<false, Body, Headers> const& msg)
+    {
+        using boost::asio::buffer;
+        auto p = append_version(buf_.data(), msg.version);
+        *p++ = ' ';
+        p = append(p, static_cast<unsigned>(msg.status));
+        *p++ = ' ';
+        b_[0] = formatted(p);
+        b_[1] = buffer(msg.reason);
+        b_[2] = boost::asio::const_buffer{"\r\n", 2};
+        i_ = 0;
+        n_ = 3;
+    }
+
+    const_iterator
+    begin() const
+    {
+        return b_.data();
+    }
+
+    const_iterator
+    end() const
+    {
+        return b_.data() + n_;
+    }
+};
+
+/*  A ConstBufferSequence representing a list of fields.
+
+    Each field is presented as four buffers: the name, the
+    separator, the value, and the line ending. The sequence
+    ends with the empty line which terminates the headers.
+    The names and values are referenced in place.
+*/
+template<class FieldSequence>
+class fields_buffers
+{
+    FieldSequence const* fields_;
+
+public:
+    using value_type = boost::asio::const_buffer;
+
+    class const_iterator;
+
+    explicit
+    fields_buffers(FieldSequence const& fields)
+        : fields_(&fields)
+    {
+    }
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    end() const;
+};
+
+template<class FieldSequence>
+class fields_buffers<FieldSequence>::const_iterator
+{
+    using iter_type =
+        typename FieldSequence::const_iterator;
+
+    FieldSequence const* fields_ = nullptr;
+    iter_type it_;
+    int n_ = 0;
+
+    friend class fields_buffers<FieldSequence>;
+
+    const_iterator(FieldSequence const& fields,
+            iter_type it, int n)
+        : fields_(&fields)
+        , it_(it)
+        , n_(n)
+    {
+    }
+
+public:
+    using value_type = boost::asio::const_buffer;
+    using pointer = value_type const*;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+    const_iterator() = default;
+    const_iterator(const_iterator&& other) = default;
+    const_iterator(const_iterator const& other) = default;
+    const_iterator& operator=(const_iterator&& other) = default;
+    const_iterator& operator=(const_iterator const& other) = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        return fields_ == other.fields_ &&
+            it_ == other.it_ && n_ == other.n_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        using boost::asio::const_buffer;
+        if(it_ == fields_->end())
+            return const_buffer{"\r\n", 2};
+        switch(n_)
+        {
+        case 0:
+        {
+            auto const s = it_->name();
+            return const_buffer{s.data(), s.size()};
+        }
+        case 1:
+            return const_buffer{": ", 2};
+        case 2:
+        {
+            auto const s = it_->value();
+            return const_buffer{s.data(), s.size()};
+        }
+        default:
+            return const_buffer{"\r\n", 2};
+        }
+    }
+
+    pointer
+    operator->() const = delete;
+
+    const_iterator&
+    operator++()
+    {
+        if(it_ == fields_->end())
+            n_ = 1;
+        else if(++n_ == 4)
+        {
+            n_ = 0;
+            ++it_;
+        }
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    const_iterator&
+    operator--()
+    {
+        if(n_ > 0 && it_ == fields_->end())
+            n_ = 0;
+        else if(n_ > 0)
+            --n_;
+        else
+        {
+            --it_;
+            n_ = 3;
+        }
+        return *this;
+    }
+
+    const_iterator
+    operator--(int)
+    {
+        auto temp = *this;
+        --(*this);
+        return temp;
+    }
+};
+
+template<class FieldSequence>
+inline
+auto
+fields_buffers<FieldSequence>::begin() const ->
+    const_iterator
+{
+    return const_iterator{*fields_, fields_->begin(), 0};
+}
+
+template<class FieldSequence>
+inline
+auto
+fields_buffers<FieldSequence>::end() const ->
+    const_iterator
+{
+    return const_iterator{*fields_, fields_->end(), 1};
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
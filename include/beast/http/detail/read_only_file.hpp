@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_READ_ONLY_FILE_HPP
+#define BEAST_HTTP_DETAIL_READ_ONLY_FILE_HPP
+
+#include <beast/core/error.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace beast {
+namespace http {
+namespace detail {
+
+inline
+error_code
+last_file_error()
+{
+    return error_code{errno,
+        boost::system::system_category()};
+}
+
+// The properties which tell apart versions of a file
+struct file_status
+{
+    std::uint64_t size = 0;
+    std::time_t mtime = 0;
+    long mtime_nsec = 0;
+    std::uint64_t device = 0;
+    std::uint64_t inode = 0;
+
+    friend
+    bool
+    operator==(file_status const& lhs, file_status const& rhs)
+    {
+        return lhs.size == rhs.size &&
+            lhs.mtime == rhs.mtime &&
+            lhs.mtime_nsec == rhs.mtime_nsec &&
+            lhs.device == rhs.device &&
+            lhs.inode == rhs.inode;
+    }
+
+    friend
+    bool
+    operator!=(file_status const& lhs, file_status const& rhs)
+    {
+        return ! (lhs == rhs);
+    }
+};
+
+// Retrieve the status of a file
+inline
+void
+file_stamp(char const* path, file_status& fs, error_code& ec)
+{
+#ifdef _WIN32
+    struct _stat64 st;
+    if(::_stat64(path, &st) != 0)
+#else
+    struct stat st;
+    if(::stat(path, &st) != 0)
+#endif
+    {
+        ec = last_file_error();
+        return;
+    }
+    fs.size = static_cast<std::uint64_t>(st.st_size);
+    fs.mtime = st.st_mtime;
+#if defined(__APPLE__)
+    fs.mtime_nsec = st.st_mtimespec.tv_nsec;
+#elif ! defined(_WIN32)
+    fs.mtime_nsec = st.st_mtim.tv_nsec;
+#endif
+    fs.device = static_cast<std::uint64_t>(st.st_dev);
+    fs.inode = static_cast<std::uint64_t>(st.st_ino);
+}
+
+#ifdef _WIN32
+
+// A file opened for reading, using the C library
+class read_only_file
+{
+    std::FILE* f_ = nullptr;
+
+public:
+    read_only_file() = default;
+    read_only_file(read_only_file const&) = delete;
+    read_only_file& operator=(read_only_file const&) = delete;
+
+    ~read_only_file()
+    {
+        if(f_)
+            std::fclose(f_);
+    }
+
+    void
+    open(char const* path, error_code& ec)
+    {
+        f_ = std::fopen(path, "rb");
+        if(! f_)
+            ec = last_file_error();
+        else
+            std::setvbuf(f_, nullptr, _IONBF, 0);
+    }
+
+    std::uint64_t
+    size(error_code& ec)
+    {
+        if(_fseeki64(f_, 0, SEEK_END) != 0)
+        {
+            ec = last_file_error();
+            return 0;
+        }
+        return static_cast<std::uint64_t>(_ftelli64(f_));
+    }
+
+    void
+    advise(std::uint64_t, std::uint64_t)
+    {
+    }
+
+    void
+    will_need(std::uint64_t, std::uint64_t)
+    {
+    }
+
+    std::size_t
+    read(std::uint64_t offset,
+        void* p, std::size_t n, error_code& ec)
+    {
+        if(_fseeki64(f_, static_cast<
+            __int64>(offset), SEEK_SET) != 0)
+        {
+            ec = last_file_error();
+            return 0;
+        }
+        auto const bytes = std::fread(p, 1, n, f_);
+        if(bytes < n && std::ferror(f_))
+            ec = last_file_error();
+        return bytes;
+    }
+};
+
+#else
+
+// A file opened for reading, using POSIX descriptors
+class read_only_file
+{
+    int fd_ = -1;
+
+public:
+    read_only_file() = default;
+    read_only_file(read_only_file const&) = delete;
+    read_only_file& operator=(read_only_file const&) = delete;
+
+    ~read_only_file()
+    {
+        if(fd_ != -1)
+            ::close(fd_);
+    }
+
+    int
+    native_handle() const
+    {
+        return fd_;
+    }
+
+    void
+    open(char const* path, error_code& ec)
+    {
+        fd_ = ::open(path, O_RDONLY);
+        if(fd_ == -1)
+            ec = last_file_error();
+    }
+
+    std::uint64_t
+    size(error_code& ec)
+    {
+        struct stat st;
+        if(::fstat(fd_, &st) != 0)
+        {
+            ec = last_file_error();
+            return 0;
+        }
+        return static_cast<std::uint64_t>(st.st_size);
+    }
+
+    // Tell the kernel the range will be read sequentially
+    void
+    advise(std::uint64_t offset, std::uint64_t len)
+    {
+#ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(fd_, static_cast<off_t>(offset),
+            static_cast<off_t>(len), POSIX_FADV_SEQUENTIAL);
+#else
+        (void)offset;
+        (void)len;
+#endif
+    }
+
+    // Ask the kernel to start reading the range into the page cache
+    void
+    will_need(std::uint64_t offset, std::uint64_t len)
+    {
+#ifdef POSIX_FADV_WILLNEED
+        ::posix_fadvise(fd_, static_cast<off_t>(offset),
+            static_cast<off_t>(len), POSIX_FADV_WILLNEED);
+#else
+        (void)offset;
+        (void)len;
+#endif
+    }
+
+    std::size_t
+    read(std::uint64_t offset,
+        void* p, std::size_t n, error_code& ec)
+    {
+        for(;;)
+        {
+            auto const bytes = ::pread(fd_, p, n,
+                static_cast<off_t>(offset));
+            if(bytes >= 0)
+                return static_cast<std::size_t>(bytes);
+            if(errno != EINTR)
+            {
+                ec = last_file_error();
+                return 0;
+            }
+        }
+    }
+};
+
+#endif
+
+} // detail
+} // http
+} // beast
+
+#endif
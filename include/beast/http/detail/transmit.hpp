@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_TRANSMIT_HPP
+#define BEAST_HTTP_DETAIL_TRANSMIT_HPP
+
+#include <beast/core/error.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <type_traits>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Determines if the stream is a plain TCP socket
+template<class T>
+struct is_tcp_socket : std::false_type
+{
+};
+
+template<class... Ts>
+struct is_tcp_socket<boost::asio::basic_stream_socket<
+        boost::asio::ip::tcp, Ts...>> : std::true_type
+{
+};
+
+template<class T>
+class has_transmit_value
+{
+    template<class U, class R = typename std::is_convertible<
+        decltype(std::declval<U&>().transmit(
+            std::declval<int>(), std::declval<error_code&>())),
+                bool>>
+    static R check(int);
+    template<class>
+    static std::false_type check(...);
+    using type = decltype(check<T>(0));
+public:
+    // `true` if `T` meets the requirements.
+    static bool const value = type::value;
+};
+
+// Determines if the writer can send its data directly to a socket
+template<class T>
+using has_transmit =
+    std::integral_constant<bool,
+        has_transmit_value<T>::value>;
+
+// Determines if the body can be sent using the writer's transmit
+template<class Stream, class Writer>
+using can_transmit =
+    std::integral_constant<bool,
+        is_tcp_socket<Stream>::value &&
+            has_transmit<Writer>::value>;
+
+// Holds back partial segments while the headers and the body
+// are sent by separate calls, so that they leave together.
+inline
+void
+cork(int sock, bool on)
+{
+#ifdef __linux__
+    int const v = on ? 1 : 0;
+    ::setsockopt(sock, IPPROTO_TCP, TCP_CORK, &v, sizeof(v));
+#else
+    (void)sock;
+    (void)on;
+#endif
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
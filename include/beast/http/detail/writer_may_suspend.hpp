@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_WRITER_MAY_SUSPEND_HPP
+#define BEAST_HTTP_DETAIL_WRITER_MAY_SUSPEND_HPP
+
+#include <beast/http/resume_context.hpp>
+#include <beast/core/error.hpp>
+#include <type_traits>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Stands in for the write function when inspecting a writer
+struct write_function_probe
+{
+    template<class ConstBufferSequence>
+    void operator()(ConstBufferSequence const&, bool = false) const;
+};
+
+template<class T>
+class writer_may_suspend_value
+{
+    template<class U, class R = std::integral_constant<bool,
+        ! std::is_same<decltype(std::declval<U&>()(
+            std::declval<resume_context>(),
+            std::declval<error_code&>(),
+            std::declval<write_function_probe>())),
+                bool>::value>>
+    static R check(int);
+    template<class>
+    static std::true_type check(...);
+    using type = decltype(check<T>(0));
+public:
+    // `true` if `T` meets the requirements.
+    static bool const value = type::value;
+};
+
+// Determines if the writer can return `boost::indeterminate`.
+// Writers which return `bool` never suspend.
+template<class T>
+using writer_may_suspend =
+    std::integral_constant<bool,
+        writer_may_suspend_value<T>::value>;
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -29,6 +29,14 @@ struct empty_body
     struct value_type {};
 #endif
 
+    /// Returns the number of octets in the body.
+    static
+    std::uint64_t
+    size(value_type const&, error_code&)
+    {
+        return 0;
+    }
+
 #if GENERATING_DOCS
 private:
 #endif
@@ -56,7 +64,7 @@ private:
         }
 
         template<class Write>
-        boost::tribool
+        bool
         operator()(resume_context&&, error_code&, Write&& write)
         {
             write(boost::asio::null_buffers{});
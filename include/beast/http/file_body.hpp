@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_FILE_BODY_HPP
+#define BEAST_HTTP_FILE_BODY_HPP
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/detail/read_only_file.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <string>
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+namespace beast {
+namespace http {
+
+/** A Body represented by a file, or a range of bytes in a file.
+
+    The file is opened when the message is serialized. When the
+    message is written synchronously or asynchronously to a
+    `boost::asio::ip::tcp::socket` on Linux, the file contents are
+    transferred by the kernel using `sendfile`, without copying them
+    through user space. Otherwise the file is read in large pieces
+    aligned to the buffer size, after advising the operating system
+    that the range will be read sequentially.
+
+    Example:
+    @code
+        response_v1<file_body> res;
+        res.body = "/var/www/index.html";
+        prepare(res);
+        write(sock, res);
+    @endcode
+
+    Meets the requirements of @b `Body`.
+*/
+struct file_body
+{
+    /// The type of the `message::body` member
+    struct value_type
+    {
+        /// The path to the file.
+        std::string path;
+
+        /// The offset of the first byte to send.
+        std::uint64_t offset = 0;
+
+        /** The number of bytes to send.
+
+            If the range extends past the end of the file, only
+            the bytes up to the end of the file are sent. The
+            default sends everything from `offset` onwards.
+        */
+        std::uint64_t size =
+            (std::numeric_limits<std::uint64_t>::max)();
+
+        /// Default constructor
+        value_type() = default;
+
+        /// Construct a body representing an entire file
+        value_type(std::string path_)
+            : path(std::move(path_))
+        {
+        }
+
+        /// Construct a body representing an entire file
+        value_type(char const* path_)
+            : path(path_)
+        {
+        }
+
+        /// Construct a body representing a range of bytes in a file
+        value_type(std::string path_,
+                std::uint64_t offset_, std::uint64_t size_)
+            : path(std::move(path_))
+            , offset(offset_)
+            , size(size_)
+        {
+        }
+    };
+
+    /** Returns the number of octets in the body.
+
+        The size of the file is determined without opening it.
+    */
+    static
+    std::uint64_t
+    size(value_type const& body, error_code& ec)
+    {
+        detail::file_status fs;
+        detail::file_stamp(body.path.c_str(), fs, ec);
+        if(ec)
+            return 0;
+        auto const file_size = fs.size;
+        if(body.offset > file_size)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::invalid_argument);
+            return 0;
+        }
+        return (std::min)(body.size, file_size - body.offset);
+    }
+
+    /// The size of the buffer used when reading the file.
+    static std::size_t constexpr buffer_size = 65536;
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class writer
+    {
+        value_type const& body_;
+        detail::read_only_file file_;
+        std::uint64_t offset_ = 0;
+        std::uint64_t remain_ = 0;
+        std::uint64_t size_ = 0;
+        // End of the part announced to the kernel for read-ahead
+        std::uint64_t ahead_ = 0;
+        std::unique_ptr<char[]> buf_;
+
+        // The most file data requested ahead of the current offset
+        static std::uint64_t constexpr read_ahead_size = 1024 * 1024;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        explicit
+        writer(message<isRequest,
+                file_body, Headers> const& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code& ec)
+        {
+            file_.open(body_.path.c_str(), ec);
+            if(ec)
+                return;
+            auto const file_size = file_.size(ec);
+            if(ec)
+                return;
+            if(body_.offset > file_size)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::invalid_argument);
+                return;
+            }
+            offset_ = body_.offset;
+            size_ = (std::min)(body_.size, file_size - offset_);
+            remain_ = size_;
+            ahead_ = offset_;
+            file_.advise(offset_, remain_);
+            read_ahead();
+        }
+
+        std::uint64_t
+        content_length() const
+        {
+            return size_;
+        }
+
+        template<class Write>
+        bool
+        operator()(resume_context&&, error_code& ec, Write&& write)
+        {
+            if(! buf_)
+                buf_.reset(new char[buffer_size]);
+            read_ahead();
+            // Keep reads aligned to the buffer size
+            auto const n = static_cast<std::size_t>((std::min)(
+                remain_, std::uint64_t{buffer_size -
+                    offset_ % buffer_size}));
+            auto const bytes =
+                file_.read(offset_, buf_.get(), n, ec);
+            if(ec)
+                return true;
+            if(bytes == 0 && n > 0)
+            {
+                // The file was truncated
+                ec = boost::asio::error::eof;
+                return true;
+            }
+            offset_ += bytes;
+            remain_ -= bytes;
+            write(boost::asio::buffer(
+                buf_.get(), bytes), remain_ == 0);
+            return remain_ == 0;
+        }
+
+#if defined(__linux__) && ! GENERATING_DOCS
+        /*  Send file data directly to a socket.
+
+            Returns `true` when all of the data has been sent.
+            If the socket is not ready, the error is set to
+            `boost::asio::error::would_block`.
+        */
+        bool
+        transmit(int sock, error_code& ec)
+        {
+            // The kernel sends at most this many bytes per call
+            std::uint64_t constexpr limit = 0x7ffff000;
+            while(remain_ > 0)
+            {
+                read_ahead();
+                auto off = static_cast<off_t>(offset_);
+                auto const bytes = ::sendfile(sock,
+                    file_.native_handle(), &off,
+                        static_cast<std::size_t>(
+                            (std::min)(remain_, limit)));
+                if(bytes < 0)
+                {
+                    if(errno == EINTR)
+                        continue;
+                    ec = detail::last_file_error();
+                    return false;
+                }
+                if(bytes == 0)
+                {
+                    // The file was truncated
+                    ec = boost::asio::error::eof;
+                    return false;
+                }
+                offset_ += bytes;
+                remain_ -= bytes;
+            }
+            return true;
+        }
+#endif
+
+    private:
+        // Keep up to read_ahead_size bytes past the offset announced,
+        // renewing the window once half of it has been consumed.
+        void
+        read_ahead()
+        {
+            auto const end = offset_ + remain_;
+            if(ahead_ >= end ||
+                    ahead_ > offset_ + read_ahead_size / 2)
+                return;
+            auto const next = (std::min)(
+                end, offset_ + read_ahead_size);
+            file_.will_need(ahead_, next - ahead_);
+            ahead_ = next;
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_PARSER_V1_HPP
+#define BEAST_HTTP_HEADER_PARSER_V1_HPP
+
+#include <beast/http/basic_parser_v1.hpp>
+#include <beast/http/empty_body.hpp>
+#include <beast/http/message_v1.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/core/error.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+/** A parser for producing the headers of HTTP/1 messages.
+
+    This class uses the basic HTTP/1 wire format parser to convert
+    a series of octets into the start line and headers of a
+    `message_v1`. Parsing pauses after the headers, so the caller
+    may inspect them before deciding how to process the body.
+    The body is then parsed by a @ref parser_v1 constructed from
+    this object, which takes over the parsed headers and the
+    parser state:
+
+    @code
+        header_parser_v1<true, headers> hp;
+        parse(sock, sb, hp);
+        if(hp.get().url == "/upload")
+        {
+            parser_v1<true, streambuf_body, headers> p{std::move(hp)};
+            parse(sock, sb, p);
+            ...
+        }
+        else
+        {
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            parse(sock, sb, p);
+            ...
+        }
+    @endcode
+
+    If the message has no body, the header parser completes the
+    message and a parser constructed from it is already complete.
+
+    @note A new instance of the parser is required for each message.
+*/
+template<bool isRequest, class Headers>
+class header_parser_v1
+    : public basic_parser_v1<isRequest,
+        header_parser_v1<isRequest, Headers>>
+    , private std::conditional<isRequest,
+        detail::parser_request, detail::parser_response>::type
+{
+public:
+    /// The type of message this parser produces.
+    using message_type =
+        message_v1<isRequest, empty_body, Headers>;
+
+private:
+    std::string field_;
+    std::string value_;
+    message_type m_;
+    std::uint8_t skip_body_ = 0;
+
+public:
+    header_parser_v1(header_parser_v1&&) = default;
+    header_parser_v1(header_parser_v1 const&) = delete;
+    header_parser_v1& operator=(header_parser_v1&&) = delete;
+    header_parser_v1& operator=(header_parser_v1 const&) = delete;
+
+    /// Default constructor
+    header_parser_v1() = default;
+
+    using basic_parser_v1<isRequest, header_parser_v1>::set_option;
+
+    /// Set the expect body option.
+    void
+    set_option(skip_body const& o)
+    {
+        skip_body_ = o.value ? 1 : 0;
+    }
+
+    /** Returns `true` if the headers are complete.
+
+        This returns `true` when the parser paused after the
+        headers, or when the message had no body and is complete.
+    */
+    bool
+    complete() const
+    {
+        return this->paused() || basic_parser_v1<isRequest,
+            header_parser_v1<isRequest, Headers>>::complete();
+    }
+
+    /** Returns the parsed message.
+
+        Only valid if `complete()` would return `true`.
+    */
+    message_type const&
+    get() const
+    {
+        return m_;
+    }
+
+    /** Returns the parsed message.
+
+        Only valid if `complete()` would return `true`.
+    */
+    message_type&
+    get()
+    {
+        return m_;
+    }
+
+private:
+    friend class basic_parser_v1<isRequest, header_parser_v1>;
+
+    void flush()
+    {
+        if(! value_.empty())
+        {
+            m_.headers.insert(field_, value_);
+            field_.clear();
+            value_.clear();
+        }
+    }
+
+    void on_method(boost::string_ref const& s, error_code&)
+    {
+        this->method_.append(s.data(), s.size());
+    }
+
+    void on_uri(boost::string_ref const& s, error_code&)
+    {
+        this->uri_.append(s.data(), s.size());
+    }
+
+    void on_reason(boost::string_ref const& s, error_code&)
+    {
+        this->reason_.append(s.data(), s.size());
+    }
+
+    void on_field(boost::string_ref const& s, error_code&)
+    {
+        flush();
+        field_.append(s.data(), s.size());
+    }
+
+    void on_value(boost::string_ref const& s, error_code&)
+    {
+        value_.append(s.data(), s.size());
+    }
+
+    void set(std::true_type)
+    {
+        m_.method = std::move(this->method_);
+        m_.url = std::move(this->uri_);
+    }
+
+    void set(std::false_type)
+    {
+        m_.status = this->status_code();
+        m_.reason = std::move(this->reason_);
+    }
+
+    int on_headers(std::uint64_t, error_code&)
+    {
+        flush();
+        m_.version = 10 * this->http_major() + this->http_minor();
+        // Pause after the headers unless the body is skipped
+        return skip_body_ ? 1 : 3;
+    }
+
+    void on_request(error_code&)
+    {
+        set(std::integral_constant<
+            bool, isRequest>{});
+    }
+
+    void on_response(error_code&)
+    {
+        set(std::integral_constant<
+            bool, isRequest>{});
+    }
+};
+
+} // http
+} // beast
+
+#endif
@@ -52,18 +52,38 @@ basic_headers_base::cend() const ->
 
 //------------------------------------------------------------------------------
 
+template<class Allocator>
+auto
+basic_headers<Allocator>::
+new_element(boost::string_ref const& name,
+    boost::string_ref const& value) ->
+        element&
+{
+    auto const p = reinterpret_cast<element*>(
+        alloc_traits::allocate(this->member(),
+            element::size(name, value)));
+    alloc_traits::construct(this->member(), p, name, value);
+    return *p;
+}
+
+template<class Allocator>
+void
+basic_headers<Allocator>::
+delete_element(element& e)
+{
+    auto const n = e.size();
+    alloc_traits::destroy(this->member(), &e);
+    alloc_traits::deallocate(this->member(),
+        reinterpret_cast<std::uint8_t*>(&e), n);
+}
+
 template<class Allocator>
 void
 basic_headers<Allocator>::
 delete_all()
 {
     for(auto it = list_.begin(); it != list_.end();)
-    {
-        auto& e = *it++;
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(
-            this->member(), &e, 1);
-    }
+        delete_element(*it++);
 }
 
 template<class Allocator>
@@ -265,8 +285,7 @@ erase(boost::string_ref const& name)
         auto& e = *it++;
         set_.erase(set_.iterator_to(e));
         list_.erase(list_.iterator_to(e));
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(this->member(), &e, 1);
+        delete_element(e);
         if(it == last)
             break;
         ++n;
@@ -281,10 +300,9 @@ insert(boost::string_ref const& name,
     boost::string_ref value)
 {
     value = detail::trim(value);
-    auto const p = alloc_traits::allocate(this->member(), 1);
-    alloc_traits::construct(this->member(), p, name, value);
-    set_.insert_before(set_.upper_bound(name, less{}), *p);
-    list_.push_back(*p);
+    auto& e = new_element(name, value);
+    set_.insert_before(set_.upper_bound(name, less{}), e);
+    list_.push_back(e);
 }
 
 template<class Allocator>
@@ -50,6 +50,31 @@ basic_parser_v1()
     init();
 }
 
+template<bool isRequest, class Derived>
+template<class OtherDerived>
+basic_parser_v1<isRequest, Derived>::
+basic_parser_v1(
+        basic_parser_v1<isRequest, OtherDerived> const& other)
+    : h_max_(other.h_max_)
+    , h_left_(other.h_left_)
+    , b_max_(other.b_max_)
+    , b_left_(other.b_left_)
+    , content_length_(other.content_length_)
+    , cb_(nullptr)
+    , ext_(other.ext_)
+    , s_(other.s_)
+    , flags_(other.flags_)
+    , fs_(other.fs_)
+    , pos_(other.pos_)
+    , http_major_(other.http_major_)
+    , http_minor_(other.http_minor_)
+    , status_code_(other.status_code_)
+    , upgrade_(other.upgrade_)
+    , paused_(other.paused_)
+{
+    BOOST_ASSERT(! other.cb_);
+}
+
 template<bool isRequest, class Derived>
 bool
 basic_parser_v1<isRequest, Derived>::
@@ -85,6 +110,14 @@ write(ConstBufferSequence const& buffers, error_code& ec)
         used += write(buffer, ec);
         if(ec)
             break;
+        // Stop at the end of the message, any
+        // remaining octets belong to the next one.
+        if(used > 0 && complete())
+            break;
+        // Stop at a pause, the caller resumes
+        // with the octets following the headers.
+        if(paused_)
+            break;
     }
     return used;
 }
@@ -95,6 +128,8 @@ basic_parser_v1<isRequest, Derived>::
 write(boost::asio::const_buffer const& buffer, error_code& ec)
 {
     using beast::http::detail::is_digit;
+    using beast::http::detail::is_qdchar;
+    using beast::http::detail::is_qpchar;
     using beast::http::detail::is_tchar;
     using beast::http::detail::is_text;
     using beast::http::detail::to_field_char;
@@ -108,6 +143,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
 
     if(size == 0 && s_ != s_dead)
         return 0;
+    paused_ = false;
 
     auto begin =
         reinterpret_cast<char const*>(data);
@@ -146,6 +182,55 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             begin = p;
         return false;
     };
+    // Header octets are counted in bulk, independently
+    // of the callbacks, starting from this position.
+    auto h = p;
+    bool pause = false;
+    auto hlimit = [&](char const* last)
+    {
+        auto const n = static_cast<std::size_t>(last - h);
+        h = last;
+        if(! h_max_)
+            return false;
+        if(n > h_left_)
+            return true;
+        h_left_ -= n;
+        return false;
+    };
+    auto blimit = [&](std::size_t n)
+    {
+        if(! b_max_)
+            return false;
+        if(n > b_left_)
+            return true;
+        b_left_ -= n;
+        return false;
+    };
+    // Chunk extensions are passed in place when the chunk
+    // header is contained in this buffer, otherwise they are
+    // accumulated in ext_ ending at the position xe.
+    char const* x = nullptr;
+    char const* xe = nullptr;
+    if(policy::chunk_header &&
+            s_ >= s_chunk_ext_ws && s_ <= s_chunk_ext_val_escape)
+        x = p;
+    auto xsave = [&](char const* last)
+    {
+        auto const n = static_cast<std::size_t>(last - x);
+        if(h_max_ && ext_.size() + n > h_max_)
+            return true;
+        ext_.append(x, n);
+        return false;
+    };
+    auto xdone = [&]
+    {
+        if(x && ext_.empty())
+            return boost::string_ref{x,
+                static_cast<std::size_t>(xe - x)};
+        if(x)
+            ext_.append(x, xe - x);
+        return boost::string_ref{ext_};
+    };
     for(;p != end; ++p)
     {
         unsigned char ch = *p;
@@ -161,6 +246,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             flags_ = 0;
             cb_ = nullptr;
             content_length_ = no_content_length;
+            h = p;
             s_ = s_req_method0;
             goto redo;
 
@@ -171,14 +257,15 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             if(ec)
                 return errc();
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_method);
+            if(policy::method)
+                cb(&self::call_on_method);
             s_ = s_req_method;
             break;
 
         case s_req_method:
             if(ch == ' ')
             {
-                if(cb(nullptr))
+                if(policy::method && cb(nullptr))
                     return errc();
                 s_ = s_req_url0;
                 break;
@@ -195,7 +282,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             if(! is_text(ch))
                 return err(parse_error::bad_uri);
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_uri);
+            if(policy::uri)
+                cb(&self::call_on_uri);
             s_ = s_req_url;
             break;
         }
@@ -203,7 +291,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_req_url:
             if(ch == ' ')
             {
-                if(cb(nullptr))
+                if(policy::uri && cb(nullptr))
                     return errc();
                 s_ = s_req_http;
                 break;
@@ -284,6 +372,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             flags_ = 0;
             cb_ = nullptr;
             content_length_ = no_content_length;
+            h = p;
             if(ch != 'H')
                 return err(parse_error::bad_version);
             call_on_start(ec);
@@ -378,14 +467,15 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             if(! is_text(ch))
                 return err(parse_error::bad_reason);
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_reason);
+            if(policy::reason)
+                cb(&self::call_on_reason);
             s_ = s_res_reason;
             break;
 
         case s_res_reason:
             if(ch == '\r')
             {
-                if(cb(nullptr))
+                if(policy::reason && cb(nullptr))
                     return errc();
                 s_ = s_res_line_lf;
                 break;
@@ -419,7 +509,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             auto c = to_field_char(ch);
             if(! c)
                 return err(parse_error::bad_field);
-            switch(c)
+            // Trailer fields are not interpreted
+            switch((flags_ & parse_flag::trailing) ? 0 : c)
             {
             case 'c': pos_ = 0; fs_ = h_C; break;
             case 'p': pos_ = 0; fs_ = h_matching_proxy_connection; break;
@@ -430,7 +521,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 break;
             }
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_field);
+            if(policy::field)
+                cb(&self::call_on_field);
             s_ = s_header_name;
             break;
         }
@@ -520,7 +612,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             if(ch == ':')
             {
-                if(cb(nullptr))
+                if(policy::field && cb(nullptr))
                     return errc();
                 s_ = s_header_value0;
                 break;
@@ -550,7 +642,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 flags_ |= parse_flag::contentlength;
             }
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_value);
+            if(policy::value)
+                cb(&self::call_on_value);
             s_ = s_header_value;
             // fall through
 
@@ -561,7 +654,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 ch = *p;
                 if(ch == '\r')
                 {
-                    if(cb(nullptr))
+                    if(policy::value && cb(nullptr))
                         return errc();
                     s_ = s_header_value_lf;
                     break;
@@ -849,6 +942,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                     break;
                 }
                 call_on_value(ec, boost::string_ref(" ", 1));
+                if(ec)
+                    return errc();
                 s_ = s_header_value_unfold;
                 break;
             }
@@ -881,7 +976,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
 
         case s_header_value_unfold:
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_value);
+            if(policy::value)
+                cb(&self::call_on_value);
             s_ = s_header_value;
             goto redo;
 
@@ -889,6 +985,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         {
             if(ch != '\n')
                 return err(parse_error::bad_crlf);
+            if(hlimit(p + 1))
+                return err(parse_error::headers_too_big);
             if(flags_ & parse_flag::trailing)
             {
                 //if(cb(&self::call_on_chunk_complete)) return errc();
@@ -912,6 +1010,9 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             case 1:
                 flags_ |= parse_flag::skipbody;
                 break;
+            case 3:
+                pause = true;
+                break;
             default:
                 return err(parse_error::bad_on_headers_rv);
             }
@@ -922,9 +1023,6 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_headers_done:
         {
             BOOST_ASSERT(! cb_);
-            call_on_headers(ec);
-            if(ec)
-                return errc();
             bool const hasBody =
                 (flags_ & parse_flag::chunked) || (content_length_ > 0 &&
                     content_length_ != no_content_length);
@@ -939,12 +1037,10 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             else if(flags_ & parse_flag::chunked)
             {
                 s_ = s_chunk_size0;
-                break;
             }
             else if(content_length_ != no_content_length)
             {
                 s_ = s_body_identity0;
-                break;
             }
             else if(! needs_eof())
             {
@@ -953,14 +1049,21 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             else
             {
                 s_ = s_body_identity_eof0;
-                break;
             }
-            goto redo;
+            if(s_ == s_complete)
+                goto redo;
+            if(pause)
+            {
+                paused_ = true;
+                return used() + 1;
+            }
+            break;
         }
 
         case s_body_identity0:
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_body);
+            if(policy::body)
+                cb(&self::call_on_body);
             s_ = s_body_identity;
             // fall through
 
@@ -972,6 +1075,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             else
                 n = static_cast<std::size_t>(content_length_);
             BOOST_ASSERT(content_length_ != 0 && content_length_ != no_content_length);
+            if(blimit(n))
+                return err(parse_error::body_too_big);
             content_length_ -= n;
             if(content_length_ == 0)
             {
@@ -985,11 +1090,14 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
 
         case s_body_identity_eof0:
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_body);
+            if(policy::body)
+                cb(&self::call_on_body);
             s_ = s_body_identity_eof;
             // fall through
 
         case s_body_identity_eof:
+            if(blimit(end - p))
+                return err(parse_error::body_too_big);
             p = end - 1;
             break;
 
@@ -1010,9 +1118,11 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 s_ = s_chunk_size_lf;
                 break;
             }
-            if(ch == ';')
+            if(ch == ';' || ch == ' ' || ch == '\t')
             {
-                s_ = s_chunk_ext_name0;
+                if(policy::chunk_header)
+                    x = p;
+                s_ = ch == ';' ? s_chunk_ext_name0 : s_chunk_ext_ws;
                 break;
             }
             auto v = unhex(ch);
@@ -1025,56 +1135,138 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             break;
         }
 
+        case s_chunk_ext_ws:
+            if(ch == ' ' || ch == '\t')
+                break;
+            if(ch == ';')
+            {
+                s_ = s_chunk_ext_name0;
+                break;
+            }
+            if(ch == '\r')
+            {
+                xe = p;
+                s_ = s_chunk_size_lf;
+                break;
+            }
+            return err(parse_error::invalid_ext_name);
+
         case s_chunk_ext_name0:
+            if(ch == ' ' || ch == '\t')
+                break;
             if(! is_tchar(ch))
                 return err(parse_error::invalid_ext_name);
             s_ = s_chunk_ext_name;
             break;
 
         case s_chunk_ext_name:
-            if(ch == '\r')
+            if(is_tchar(ch))
+                break;
+            // fall through
+
+        case s_chunk_ext_name_ws:
+            switch(ch)
             {
+            case ' ':
+            case '\t':
+                s_ = s_chunk_ext_name_ws;
+                break;
+            case '=':
+                s_ = s_chunk_ext_val0;
+                break;
+            case ';':
+                s_ = s_chunk_ext_name0;
+                break;
+            case '\r':
+                xe = p;
                 s_ = s_chunk_size_lf;
                 break;
+            default:
+                return err(parse_error::invalid_ext_name);
             }
-            if(ch == '=')
-            {
-                s_ = s_chunk_ext_val;
+            break;
+
+        case s_chunk_ext_val0:
+            if(ch == ' ' || ch == '\t')
                 break;
-            }
-            if(ch == ';')
+            if(ch == '"')
             {
-                s_ = s_chunk_ext_name0;
+                s_ = s_chunk_ext_val_quoted;
                 break;
             }
             if(! is_tchar(ch))
-                return err(parse_error::invalid_ext_name);
+                return err(parse_error::invalid_ext_val);
+            s_ = s_chunk_ext_val;
             break;
 
         case s_chunk_ext_val:
-            if(ch == '\r')
+            if(is_tchar(ch))
+                break;
+            switch(ch)
             {
+            case ' ':
+            case '\t':
+                s_ = s_chunk_ext_ws;
+                break;
+            case ';':
+                s_ = s_chunk_ext_name0;
+                break;
+            case '\r':
+                xe = p;
                 s_ = s_chunk_size_lf;
                 break;
+            default:
+                return err(parse_error::invalid_ext_val);
+            }
+            break;
+
+        case s_chunk_ext_val_quoted:
+            if(ch == '"')
+            {
+                s_ = s_chunk_ext_ws;
+                break;
             }
+            if(ch == '\\')
+            {
+                s_ = s_chunk_ext_val_escape;
+                break;
+            }
+            if(! is_qdchar(ch))
+                return err(parse_error::invalid_ext_val);
+            break;
+
+        case s_chunk_ext_val_escape:
+            if(! is_qpchar(ch))
+                return err(parse_error::invalid_ext_val);
+            s_ = s_chunk_ext_val_quoted;
             break;
 
         case s_chunk_size_lf:
             if(ch != '\n')
                 return err(parse_error::bad_crlf);
+            if(policy::chunk_header)
+            {
+                call_on_chunk_header(
+                    ec, content_length_, xdone());
+                x = nullptr;
+                ext_.clear();
+                if(ec)
+                    return errc();
+            }
             if(content_length_ == 0)
             {
                 flags_ |= parse_flag::trailing;
+                h = p + 1;
                 s_ = s_header_name0;
                 break;
             }
-            //call_chunk_header(ec); if(ec) return errc();
             s_ = s_chunk_data0;
             break;
 
         case s_chunk_data0:
             BOOST_ASSERT(! cb_);
-            cb(&self::call_on_body);
+            if(policy::body)
+                cb(&self::call_on_body);
             s_ = s_chunk_data;
             goto redo; // VFALCO fall through?
 
@@ -1085,6 +1277,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 n = end - p;
             else
                 n = static_cast<std::size_t>(content_length_);
+            if(blimit(n))
+                return err(parse_error::body_too_big);
             content_length_ -= n;
             p += n - 1;
             if(content_length_ == 0)
@@ -1095,7 +1289,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_chunk_data_cr:
             if(ch != '\r')
                 return err(parse_error::bad_crlf);
-            if(cb(nullptr))
+            if(policy::body && cb(nullptr))
                 return errc();
             s_ = s_chunk_data_lf;
             break;
@@ -1108,7 +1302,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
 
         case s_complete:
             ++p;
-            if(cb(nullptr))
+            if(policy::body && cb(nullptr))
                 return errc();
             call_on_complete(ec);
             if(ec)
@@ -1124,7 +1318,13 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             goto redo;
         }
     }
-    if(cb_)
+    if(s_ >= s_req_start && s_ <= s_headers_almost_done)
+        if(hlimit(end))
+            return err(parse_error::headers_too_big);
+    if(policy::chunk_header && x)
+        if(xsave(s_ == s_chunk_size_lf ? xe : end))
+            return err(parse_error::headers_too_big);
+    if(policy::any && cb_)
     {
         (this->*cb_)(ec, piece());
         if(ec)
@@ -1133,6 +1333,38 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     return used();
 }
 
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+consume_body(std::size_t n, error_code& ec)
+{
+    BOOST_ASSERT(n <= body_remain());
+    paused_ = false;
+    if(n == 0)
+        return;
+    if(b_max_)
+    {
+        if(n > b_left_)
+        {
+            ec = parse_error::body_too_big;
+            s_ = s_dead;
+            return;
+        }
+        b_left_ -= n;
+    }
+    content_length_ -= n;
+    if(content_length_ > 0)
+        return;
+    cb_ = nullptr;
+    call_on_complete(ec);
+    if(ec)
+    {
+        s_ = s_dead;
+        return;
+    }
+    s_ = s_restart;
+}
+
 template<bool isRequest, class Derived>
 void
 basic_parser_v1<isRequest, Derived>::
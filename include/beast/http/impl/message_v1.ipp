@@ -9,6 +9,7 @@
 #define BEAST_HTTP_IMPL_MESSAGE_V1_IPP
 
 #include <beast/core/error.hpp>
+#include <beast/core/detail/format_number.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/http/detail/has_content_length.hpp>
 #include <boost/optional.hpp>
@@ -81,11 +82,25 @@ prepare_options(prepare_info& pi,
         std::forward<Opts>(opts)...);
 }
 
+template<bool isRequest, class Body, class Headers,
+    class HasContentLength>
+void
+prepare_content_length(prepare_info& pi,
+    message_v1<isRequest, Body, Headers> const& msg,
+        std::true_type, HasContentLength)
+{
+    error_code ec;
+    auto const n = Body::size(msg.body, ec);
+    if(ec)
+        throw system_error{ec};
+    pi.content_length = n;
+}
+
 template<bool isRequest, class Body, class Headers>
 void
 prepare_content_length(prepare_info& pi,
     message_v1<isRequest, Body, Headers> const& msg,
-        std::true_type)
+        std::false_type, std::true_type)
 {
     typename Body::writer w(msg);
     // VFALCO This is a design problem!
@@ -100,7 +115,7 @@ template<bool isRequest, class Body, class Headers>
 void
 prepare_content_length(prepare_info& pi,
     message_v1<isRequest, Body, Headers> const& msg,
-        std::false_type)
+        std::false_type, std::false_type)
 {
     pi.content_length = boost::none;
 }
@@ -119,7 +134,8 @@ prepare(message_v1<isRequest, Body, Headers>& msg,
     //  "WritableBody requirements not met");
     detail::prepare_info pi;
     detail::prepare_content_length(pi, msg,
-        detail::has_content_length<typename Body::writer>{});
+        detail::has_size<Body>{},
+            detail::has_content_length<typename Body::writer>{});
     detail::prepare_options(pi, msg,
         std::forward<Options>(options)...);
 
@@ -139,9 +155,12 @@ prepare(message_v1<isRequest, Body, Headers>& msg,
     {
         if(pi.content_length)
         {
-            // VFALCO TODO Use a static string here
+            char buf[beast::detail::max_number_chars];
+            auto const end = buf + sizeof(buf);
+            auto const first = beast::detail::format_integer(
+                end, *pi.content_length);
             msg.headers.insert("Content-Length",
-                std::to_string(*pi.content_length));
+                boost::string_ref(first, end - first));
         }
         else if(msg.version >= 11)
         {
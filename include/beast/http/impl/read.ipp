@@ -9,17 +9,121 @@
 #define BEAST_HTTP_IMPL_READ_IPP_HPP
 
 #include <beast/http/concepts.hpp>
+#include <beast/http/header_parser_v1.hpp>
 #include <beast/http/parser_v1.hpp>
 #include <beast/core/bind_handler.hpp>
+#include <beast/core/consuming_buffers.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <boost/assert.hpp>
+#include <tuple>
+#include <type_traits>
 
 namespace beast {
 namespace http {
 
 namespace detail {
 
+// Returns the arguments which construct an empty object using
+// the allocator of `t`, or no arguments if `t` has no allocator.
+// This lets a parser build its message with the allocators of
+// the destination, which may not be default constructible.
+template<class T>
+auto
+allocator_args(T const& t, int) ->
+    typename std::enable_if<std::is_constructible<
+        T, decltype(t.get_allocator())>::value,
+            std::tuple<decltype(t.get_allocator())>>::type
+{
+    return std::tuple<decltype(
+        t.get_allocator())>{t.get_allocator()};
+}
+
+template<class T>
+std::tuple<>
+allocator_args(T const&, long)
+{
+    return {};
+}
+
+// Determine if the parser can store body octets directly
+template<class T>
+class is_DirectParser
+{
+    template<class U, class R = decltype(
+        std::declval<U&>().body_remain(),
+        std::declval<U&>().prepare_body(0),
+        std::declval<U&>().commit_body(0,
+            std::declval<error_code&>()),
+                std::true_type{})>
+    static R check(int);
+    template<class>
+    static std::false_type check(...);
+public:
+    using type = decltype(check<T>(0));
+};
+
+// Returns the number of body octets which may be read from
+// the stream directly into the body, or zero if the octets
+// must be presented to the parser through the dynamic buffer.
+template<class DynamicBuffer, class Parser>
+std::size_t
+direct_read_size(DynamicBuffer const&, Parser const&,
+    std::false_type)
+{
+    return 0;
+}
+
+template<class DynamicBuffer, class Parser>
+std::size_t
+direct_read_size(DynamicBuffer const& dynabuf,
+    Parser const& parser, std::true_type)
+{
+    if(dynabuf.size() > 0)
+        return 0;
+    auto const n = parser.body_remain();
+    if(n > 65536)
+        return 65536;
+    return static_cast<std::size_t>(n);
+}
+
+template<class Parser>
+void
+direct_commit(Parser&, std::size_t,
+    error_code&, std::false_type)
+{
+}
+
+// Commits octets read directly into the body. The reader
+// is always informed, even if the read produced an error.
+template<class Parser>
+void
+direct_commit(Parser& parser, std::size_t n,
+    error_code& ec, std::true_type)
+{
+    error_code ev;
+    parser.commit_body(n, ev);
+    if(! ec)
+        ec = ev;
+}
+
+template<class SyncReadStream, class Parser>
+void
+direct_read_some(SyncReadStream&, Parser&,
+    std::size_t, error_code&, std::false_type)
+{
+}
+
+template<class SyncReadStream, class Parser>
+void
+direct_read_some(SyncReadStream& stream, Parser& parser,
+    std::size_t size, error_code& ec, std::true_type)
+{
+    auto const n = stream.read_some(
+        parser.prepare_body(size), ec);
+    direct_commit(parser, n, ec, std::true_type{});
+}
+
 template<class Stream,
     class DynamicBuffer, class Parser, class Handler>
 class parse_op
@@ -27,6 +131,9 @@ class parse_op
     using alloc_type =
         handler_alloc<char, Handler>;
 
+    using is_direct =
+        typename is_DirectParser<Parser>::type;
+
     struct data
     {
         Stream& s;
@@ -98,6 +205,20 @@ public:
         return boost_asio_handler_invoke_helpers::
             invoke(f, op->d_->h);
     }
+
+private:
+    void
+    read_body(std::size_t, std::false_type)
+    {
+    }
+
+    void
+    read_body(std::size_t size, std::true_type)
+    {
+        auto& d = *d_;
+        d.s.async_read_some(
+            d.p.prepare_body(size), std::move(*this));
+    }
 };
 
 template<class Stream,
@@ -114,6 +235,14 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
         {
         case 0:
         {
+            if(d.p.complete())
+            {
+                // call handler
+                d.state = 99;
+                d.s.get_io_service().post(
+                    bind_handler(std::move(*this), ec, 0));
+                return;
+            }
             auto const used =
                 d.p.write(d.db.data(), ec);
             if(ec)
@@ -140,12 +269,30 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
         }
 
         case 1:
+        {
+            auto const size =
+                direct_read_size(d.db, d.p, is_direct{});
+            if(size > 0)
+            {
+                // read into the body
+                d.state = 3;
+                read_body(size, is_direct{});
+                return;
+            }
             // read
             d.state = 2;
             d.s.async_read_some(d.db.prepare(
                 read_size_helper(d.db, 65536)),
                     std::move(*this));
             return;
+        }
+
+        // got body data
+        case 3:
+            direct_commit(d.p,
+                bytes_transferred, ec, is_direct{});
+            bytes_transferred = 0;
+            // fall through
 
         // got data
         case 2:
@@ -230,6 +377,9 @@ class read_op
             : s(s_)
             , db(sb_)
             , m(m_)
+            , p(std::piecewise_construct,
+                allocator_args(m_.body, 0),
+                allocator_args(m_.headers, 0))
             , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
@@ -314,6 +464,165 @@ operator()(error_code ec, bool again)
     d.h(ec);
 }
 
+//------------------------------------------------------------------------------
+
+// Parse the complete messages already in the buffer. An
+// incomplete or invalid message is left for the next read.
+// The headers are parsed first, so a message whose headers
+// or Content-Length body have not fully arrived is left
+// without presenting any of its body to a parser. Messages
+// are built with the allocators of the last one read.
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+parse_pipelined(DynamicBuffer& dynabuf, std::vector<
+    message_v1<isRequest, Body, Headers>, Allocator>& msgs)
+{
+    BOOST_ASSERT(! msgs.empty());
+    while(dynabuf.size() > 0)
+    {
+        header_parser_v1<isRequest, Headers> hp;
+        error_code ec;
+        auto used = hp.write(dynabuf.data(), ec);
+        if(ec || ! hp.complete())
+            break;
+        if(hp.body_remain() > dynabuf.size() - used)
+            break;
+        parser_v1<isRequest, Body, Headers> p(std::move(hp),
+            std::piecewise_construct,
+                allocator_args(msgs.back().body, 0),
+                allocator_args(msgs.back().headers, 0));
+        if(! p.complete())
+        {
+            used += p.write(consumed_buffers(
+                dynabuf.data(), used), ec);
+            if(ec || ! p.complete())
+                break;
+        }
+        dynabuf.consume(used);
+        msgs.emplace_back(p.release());
+        if(! p.keep_alive() || p.upgrade())
+            break;
+    }
+}
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class Handler>
+class read_pipelined_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    using parser_type =
+        parser_v1<isRequest, Body, Headers>;
+
+    using message_type =
+        message_v1<isRequest, Body, Headers>;
+
+    struct data
+    {
+        Stream& s;
+        DynamicBuffer& db;
+        std::vector<message_type, Allocator>& v;
+        parser_type p;
+        Handler h;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_, DynamicBuffer& sb_,
+                std::vector<message_type, Allocator>& v_)
+            : s(s_)
+            , db(sb_)
+            , v(v_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    read_pipelined_op(read_pipelined_op&&) = default;
+    read_pipelined_op(read_pipelined_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    read_pipelined_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, false);
+    }
+
+    void
+    operator()(error_code ec, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, read_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, read_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(read_pipelined_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, read_pipelined_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class Handler>
+void
+read_pipelined_op<Stream, DynamicBuffer, isRequest,
+    Body, Headers, Allocator, Handler>::
+operator()(error_code ec, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = 1;
+            async_parse(d.s, d.db, d.p, std::move(*this));
+            return;
+
+        case 1:
+            // call handler
+            d.state = 99;
+            d.v.emplace_back(d.p.release());
+            if(d.p.keep_alive() && ! d.p.upgrade())
+                parse_pipelined(d.db, d.v);
+            break;
+        }
+    }
+    d.h(ec);
+}
+
 } // detail
 
 //------------------------------------------------------------------------------
@@ -346,6 +655,10 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
         "DynamicBuffer requirements not met");
     static_assert(is_Parser<Parser>::value,
         "Parser requirements not met");
+    using is_direct =
+        typename detail::is_DirectParser<Parser>::type;
+    if(parser.complete())
+        return;
     bool started = false;
     for(;;)
     {
@@ -358,9 +671,15 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
             started = true;
         if(parser.complete())
             break;
-        dynabuf.commit(stream.read_some(
-            dynabuf.prepare(read_size_helper(
-                dynabuf, 65536)), ec));
+        auto const size = detail::direct_read_size(
+            dynabuf, parser, is_direct{});
+        if(size > 0)
+            detail::direct_read_some(
+                stream, parser, size, ec, is_direct{});
+        else
+            dynabuf.commit(stream.read_some(
+                dynabuf.prepare(read_size_helper(
+                    dynabuf, 65536)), ec));
         if(ec && ec != boost::asio::error::eof)
             return;
         if(ec == boost::asio::error::eof)
@@ -430,7 +749,9 @@ read(SyncReadStream& stream, DynamicBuffer& dynabuf,
         "DynamicBuffer requirements not met");
     static_assert(is_ReadableBody<Body>::value,
         "ReadableBody requirements not met");
-    parser_v1<isRequest, Body, Headers> p;
+    parser_v1<isRequest, Body, Headers> p(std::piecewise_construct,
+        detail::allocator_args(m.body, 0),
+        detail::allocator_args(m.headers, 0));
     beast::http::parse(stream, dynabuf, p, ec);
     if(ec)
         return;
@@ -462,6 +783,71 @@ async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
     return completion.result.get();
 }
 
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_ReadableBody<Body>::value,
+        "ReadableBody requirements not met");
+    error_code ec;
+    beast::http::read_pipelined(stream, dynabuf, msgs, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_ReadableBody<Body>::value,
+        "ReadableBody requirements not met");
+    parser_v1<isRequest, Body, Headers> p;
+    beast::http::parse(stream, dynabuf, p, ec);
+    if(ec)
+        return;
+    BOOST_ASSERT(p.complete());
+    msgs.emplace_back(p.release());
+    if(p.keep_alive() && ! p.upgrade())
+        detail::parse_pipelined(dynabuf, msgs);
+}
+
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_read_pipelined(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs,
+        ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_ReadableBody<Body>::value,
+        "ReadableBody requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    detail::read_pipelined_op<AsyncReadStream, DynamicBuffer,
+        isRequest, Body, Headers, Allocator, decltype(
+            completion.handler)>{completion.handler,
+                stream, dynabuf, msgs};
+    return completion.result.get();
+}
+
 } // http
 } // beast
 
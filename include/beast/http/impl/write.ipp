@@ -12,15 +12,18 @@
 #include <beast/http/resume_context.hpp>
 #include <beast/http/detail/chunk_encode.hpp>
 #include <beast/http/detail/has_content_length.hpp>
+#include <beast/http/detail/header_buffers.hpp>
+#include <beast/http/detail/transmit.hpp>
+#include <beast/http/detail/writer_may_suspend.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/handler_alloc.hpp>
+#include <beast/core/static_buffer_list.hpp>
 #include <beast/core/stream_concepts.hpp>
-#include <beast/core/streambuf.hpp>
-#include <beast/core/write_dynabuf.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/logic/tribool.hpp>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <ostream>
@@ -32,71 +35,31 @@ namespace http {
 
 namespace detail {
 
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message_v1<true, Body, Headers> const& msg)
-{
-    write(dynabuf, msg.method);
-    write(dynabuf, " ");
-    write(dynabuf, msg.url);
-    write(dynabuf, " HTTP/");
-    write(dynabuf, msg.version / 10);
-    write(dynabuf, ".");
-    write(dynabuf, msg.version % 10);
-    write(dynabuf, "\r\n");
-}
-
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message_v1<false, Body, Headers> const& msg)
-{
-    write(dynabuf, "HTTP/");
-    write(dynabuf, msg.version / 10);
-    write(dynabuf, ".");
-    write(dynabuf, msg.version % 10);
-    write(dynabuf, " ");
-    write(dynabuf, msg.status);
-    write(dynabuf, " ");
-    write(dynabuf, msg.reason);
-    write(dynabuf, "\r\n");
-}
-
-template<class DynamicBuffer, class FieldSequence>
-void
-write_fields(DynamicBuffer& dynabuf, FieldSequence const& fields)
-{
-    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
-        "DynamicBuffer requirements not met");
-    //static_assert(is_FieldSequence<FieldSequence>::value,
-    //    "FieldSequence requirements not met");
-    for(auto const& field : fields)
-    {
-        write(dynabuf, field.name());
-        write(dynabuf, ": ");
-        write(dynabuf, field.value());
-        write(dynabuf, "\r\n");
-    }
-}
-
 template<bool isRequest, class Body, class Headers>
 struct write_preparation
 {
     using headers_type =
         basic_headers<std::allocator<char>>;
 
+    using header_buffers_type =
+        beast::detail::buffer_cat_helper<
+            boost::asio::const_buffer,
+                start_line_buffers, fields_buffers<Headers>>;
+
     message_v1<isRequest, Body, Headers> const& msg;
     typename Body::writer w;
-    streambuf sb;
+    header_buffers_type hb;
     bool chunked;
     bool close;
+    bool last = false;
 
     explicit
     write_preparation(
             message_v1<isRequest, Body, Headers> const& msg_)
         : msg(msg_)
         , w(msg)
+        , hb(start_line_buffers{msg},
+            fields_buffers<Headers>{msg.headers})
         , chunked(token_list{
             msg.headers["Transfer-Encoding"]}.exists("chunked"))
         , close(token_list{
@@ -110,11 +73,6 @@ struct write_preparation
     init(error_code& ec)
     {
         w.init(ec);
-        if(ec)
-            return;
-        write_firstline(sb, msg);
-        write_fields(sb, msg.headers);
-        beast::write(sb, "\r\n");
     }
 };
 
@@ -128,12 +86,23 @@ class write_op
     struct data
     {
         Stream& s;
-        // VFALCO How do we use handler_alloc in write_preparation?
+        // The header buffers refer to the message, so the
+        // handler's allocator provides all of the state.
         write_preparation<
             isRequest, Body, Headers> wp;
         Handler h;
-        resume_context resume;
-        resume_context copy;
+        // Keeps the state alive while the writer is suspended
+        std::shared_ptr<data> pending;
+        // A write started by the writer may complete on another
+        // thread before the writer returns. Whichever of the two
+        // finishes last continues the operation.
+        std::atomic<bool> joined{false};
+        bool wrote = false;
+        int next = 0;
+        error_code ec;
+        error_code writer_ec;
+        // The socket was switched to non-blocking for transmit
+        bool restore = false;
         bool cont;
         int state = 0;
 
@@ -147,6 +116,28 @@ class write_op
                 is_continuation(h))
         {
         }
+
+        // Called through the resume_context
+        void
+        resume()
+        {
+            write_op self(std::move(pending));
+            self.d_->cont = false;
+            error_code ec;
+            if(state == 2)
+            {
+                // The writer suspended after a write. Whichever
+                // of the resume and the write completion comes
+                // last continues the operation.
+                if(! joined.exchange(true))
+                    return;
+                ec = this->ec;
+                state = next;
+            }
+            auto& ios = self.d_->s.get_io_service();
+            ios.dispatch(bind_handler(std::move(self),
+                ec, 0, false));
+        }
     };
 
     class writef0_lambda
@@ -161,19 +152,39 @@ class write_op
         }
 
         template<class ConstBufferSequence>
-        void operator()(ConstBufferSequence const& buffers)
+        void operator()(ConstBufferSequence const& buffers,
+            bool last = false)
         {
             auto& d = *self_.d_;
+            d.wrote = true;
+            d.joined = false;
+            d.state = 2;
             // write headers and body
-            if(d.wp.chunked)
+            if(d.wp.chunked && last)
+            {
+                // write headers, body, and final chunk
+                d.wp.last = true;
+                if(boost::asio::buffer_size(buffers) > 0)
+                    boost::asio::async_write(d.s,
+                        buffer_cat(d.wp.hb,
+                            detail::chunk_encode(buffers),
+                                detail::chunk_encode_final()),
+                                    write_op{self_});
+                else
+                    boost::asio::async_write(d.s,
+                        buffer_cat(d.wp.hb,
+                            detail::chunk_encode_final()),
+                                write_op{self_});
+            }
+            else if(d.wp.chunked)
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                    buffer_cat(d.wp.hb,
                         detail::chunk_encode(buffers)),
-                            std::move(self_));
+                            write_op{self_});
             else
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
-                        buffers), std::move(self_));
+                    buffer_cat(d.wp.hb,
+                        buffers), write_op{self_});
         }
     };
 
@@ -189,22 +200,71 @@ class write_op
         }
 
         template<class ConstBufferSequence>
-        void operator()(ConstBufferSequence const& buffers)
+        void operator()(ConstBufferSequence const& buffers,
+            bool last = false)
         {
             auto& d = *self_.d_;
+            d.wrote = true;
+            d.joined = false;
+            d.state = 2;
             // write body
-            if(d.wp.chunked)
+            if(d.wp.chunked && last)
+            {
+                // write body and final chunk
+                d.wp.last = true;
+                if(boost::asio::buffer_size(buffers) > 0)
+                    boost::asio::async_write(d.s,
+                        buffer_cat(detail::chunk_encode(buffers),
+                            detail::chunk_encode_final()),
+                                write_op{self_});
+                else
+                    boost::asio::async_write(d.s,
+                        detail::chunk_encode_final(),
+                            write_op{self_});
+            }
+            else if(d.wp.chunked)
                 boost::asio::async_write(d.s,
                     detail::chunk_encode(buffers),
-                        std::move(self_));
+                        write_op{self_});
             else
                 boost::asio::async_write(d.s,
-                    buffers, std::move(self_));
+                    buffers, write_op{self_});
         }
     };
 
     std::shared_ptr<data> d_;
 
+    using is_transmit = can_transmit<
+        Stream, typename Body::writer>;
+
+    bool
+    transmit(error_code& ec, std::true_type);
+
+    bool
+    transmit(error_code&, std::false_type)
+    {
+        return false;
+    }
+
+    void
+    cork(bool on, std::true_type)
+    {
+        detail::cork(d_->s.native_handle(), on);
+    }
+
+    void
+    cork(bool, std::false_type)
+    {
+    }
+
+    void
+    end_transmit(std::true_type);
+
+    void
+    end_transmit(std::false_type)
+    {
+    }
+
 public:
     write_op(write_op&&) = default;
     write_op(write_op const&) = default;
@@ -215,18 +275,6 @@ public:
             std::forward<DeducedHandler>(h), s,
                 std::forward<Args>(args)...))
     {
-        auto& d = *d_;
-        auto sp = d_;
-        d.resume = {
-            [sp]() mutable
-            {
-                write_op self(std::move(sp));
-                self.d_->cont = false;
-                auto& ios = self.d_->s.get_io_service();
-                ios.dispatch(bind_handler(std::move(self),
-                    error_code{}, 0, false));
-            }};
-        d.copy = d.resume;
         (*this)(error_code{}, 0, false);
     }
 
@@ -278,6 +326,16 @@ write_op<Stream, Handler, isRequest, Body, Headers>::
 operator()(error_code ec, std::size_t, bool again)
 {
     auto& d = *d_;
+    if(d.state == 2)
+    {
+        // sent buffers from the writer
+        d.ec = ec;
+        if(! d.joined.exchange(true))
+            return;
+        if(! ec)
+            ec = d.writer_ec;
+        d.state = d.next;
+    }
     d.cont = d.cont || again;
     while(! ec && d.state != 99)
     {
@@ -294,68 +352,76 @@ operator()(error_code ec, std::size_t, bool again)
                     std::move(*this), ec, 0, false));
                 return;
             }
+            if(is_transmit::value && ! d.wp.chunked)
+            {
+                // write headers
+                d.state = 6;
+                cork(true, is_transmit{});
+                boost::asio::async_write(d.s,
+                    d.wp.hb, std::move(*this));
+                return;
+            }
             d.state = 1;
             break;
         }
 
         case 1:
+        case 3:
         {
-            auto const result = d.wp.w(
-                std::move(d.copy), ec, writef0_lambda{*this});
-            if(ec)
+            auto const state = d.state;
+            d.wrote = false;
+            d.pending = d_;
+            auto const result = state == 1 ?
+                d.wp.w(resume_context{d}, ec, writef0_lambda{*this}) :
+                d.wp.w(resume_context{d}, ec, writef_lambda{*this});
+            if(boost::indeterminate(result))
             {
-                // call handler
-                d.state = 99;
-                d.s.get_io_service().post(bind_handler(
-                    std::move(*this), ec, false));
+                // suspend
+                if(d.wrote)
+                {
+                    // The write completion joins with
+                    // the resume instead of the return.
+                    d.writer_ec = {};
+                    d.next = 3;
+                }
                 return;
             }
-            if(boost::indeterminate(result))
+            d.pending.reset();
+            auto const next = result ?
+                (d.wp.chunked && ! d.wp.last ? 4 : 5) : 3;
+            if(d.wrote)
             {
-                // suspend
-                d.copy = d.resume;
+                d.writer_ec = ec;
+                d.next = next;
+                if(! d.joined.exchange(true))
+                    return;
+                // The write already completed, continue
+                // without invoking the handler from here.
+                if(! ec)
+                    ec = d.ec;
+                d.state = ec ? 99 : next;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), ec, 0, false));
                 return;
             }
-            if(result)
-                d.state = d.wp.chunked ? 4 : 5;
-            else
-                d.state = 2;
-            return;
-        }
-
-        // sent headers and body
-        case 2:
-            d.wp.sb.consume(d.wp.sb.size());
-            d.state = 3;
-            break;
-
-        case 3:
-        {
-            auto const result = d.wp.w(
-                std::move(d.copy), ec, writef_lambda{*this});
             if(ec)
             {
                 // call handler
                 d.state = 99;
-                break;
-            }
-            if(boost::indeterminate(result))
-            {
-                // suspend
-                d.copy = d.resume;
+                if(state == 3)
+                    break;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), ec, 0, false));
                 return;
             }
             if(result)
-                d.state = d.wp.chunked ? 4 : 5;
-            else
-                d.state = 2;
-            return;
+                d.state = next;
+            break;
         }
 
         case 4:
-            // VFALCO Unfortunately the current interface to the
-            //        Writer concept prevents us from coalescing the
-            //        final body chunk with the final chunk delimiter.
+            // The writer did not mark its last buffers,
+            // so the final chunk is sent separately.
             //
             // write final chunk
             d.state = 5;
@@ -371,72 +437,298 @@ operator()(error_code ec, std::size_t, bool again)
             }
             d.state = 99;
             break;
+
+        // sent headers
+        case 6:
+        case 7:
+            // send body directly from the writer
+            if(transmit(ec, is_transmit{}))
+                return;
+            break;
         }
     }
+    if(d.state == 6 || d.state == 7)
+        end_transmit(is_transmit{});
     d.h(ec);
-    d.resume = {};
-    d.copy = {};
 }
 
-template<class SyncWriteStream, class DynamicBuffer>
+template<class Stream, class Handler,
+    bool isRequest, class Body, class Headers>
+bool
+write_op<Stream, Handler, isRequest, Body, Headers>::
+transmit(error_code& ec, std::true_type)
+{
+    auto& d = *d_;
+    if(d.state == 6)
+    {
+        d.state = 7;
+        if(! d.s.native_non_blocking())
+        {
+            d.s.native_non_blocking(true, ec);
+            if(ec)
+                return false;
+            d.restore = true;
+        }
+    }
+    auto const done = d.wp.w.transmit(
+        d.s.native_handle(), ec);
+    if(ec == boost::asio::error::would_block ||
+        ec == boost::asio::error::try_again)
+    {
+        // wait until the socket is ready
+        ec = {};
+        d.s.async_write_some(boost::asio::null_buffers{},
+            std::move(*this));
+        return true;
+    }
+    if(! ec && done)
+    {
+        end_transmit(is_transmit{});
+        d.state = 5;
+    }
+    return false;
+}
+
+// Undo the socket settings made for transmit, so
+// the caller finds the socket as it was before.
+template<class Stream, class Handler,
+    bool isRequest, class Body, class Headers>
+void
+write_op<Stream, Handler, isRequest, Body, Headers>::
+end_transmit(std::true_type)
+{
+    auto& d = *d_;
+    detail::cork(d.s.native_handle(), false);
+    if(d.restore)
+    {
+        d.restore = false;
+        error_code ev;
+        d.s.native_non_blocking(false, ev);
+    }
+}
+
+// Write a buffer sequence. When it fits, the sequence is first
+// gathered into a flat list so the stream is given plain buffers.
+template<class SyncWriteStream, class ConstBufferSequence>
+void
+write_buffers(SyncWriteStream& stream,
+    ConstBufferSequence const& buffers, error_code& ec)
+{
+    static_buffer_list<64> bl;
+    if(! bl.append(buffers))
+    {
+        boost::asio::write(stream, buffers, ec);
+        return;
+    }
+    ec = {};
+    while(! bl.empty())
+    {
+        auto const n = stream.write_some(bl, ec);
+        if(ec)
+            return;
+        bl.consume(n);
+    }
+}
+
+template<class SyncWriteStream, class WritePreparation>
 class writef0_lambda
 {
-    DynamicBuffer const& sb_;
+    WritePreparation& wp_;
     SyncWriteStream& stream_;
-    bool chunked_;
     error_code& ec_;
 
 public:
     writef0_lambda(SyncWriteStream& stream,
-            DynamicBuffer const& sb, bool chunked, error_code& ec)
-        : sb_(sb)
+            WritePreparation& wp, error_code& ec)
+        : wp_(wp)
         , stream_(stream)
-        , chunked_(chunked)
         , ec_(ec)
     {
     }
 
     template<class ConstBufferSequence>
-    void operator()(ConstBufferSequence const& buffers)
+    void operator()(ConstBufferSequence const& buffers,
+        bool last = false)
     {
         // write headers and body
-        if(chunked_)
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), detail::chunk_encode(buffers)), ec_);
+        if(wp_.chunked && last)
+        {
+            // write headers, body, and final chunk
+            wp_.last = true;
+            if(boost::asio::buffer_size(buffers) > 0)
+                write_buffers(stream_, buffer_cat(wp_.hb,
+                    detail::chunk_encode(buffers),
+                        detail::chunk_encode_final()), ec_);
+            else
+                write_buffers(stream_, buffer_cat(wp_.hb,
+                    detail::chunk_encode_final()), ec_);
+        }
+        else if(wp_.chunked)
+            write_buffers(stream_, buffer_cat(
+                wp_.hb, detail::chunk_encode(buffers)), ec_);
         else
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), buffers), ec_);
+            write_buffers(stream_, buffer_cat(
+                wp_.hb, buffers), ec_);
     }
 };
 
-template<class SyncWriteStream>
+template<class SyncWriteStream, class WritePreparation>
 class writef_lambda
 {
+    WritePreparation& wp_;
     SyncWriteStream& stream_;
-    bool chunked_;
     error_code& ec_;
 
 public:
     writef_lambda(SyncWriteStream& stream,
-            bool chunked, error_code& ec)
-        : stream_(stream)
-        , chunked_(chunked)
+            WritePreparation& wp, error_code& ec)
+        : wp_(wp)
+        , stream_(stream)
         , ec_(ec)
     {
     }
 
     template<class ConstBufferSequence>
-    void operator()(ConstBufferSequence const& buffers)
+    void operator()(ConstBufferSequence const& buffers,
+        bool last = false)
     {
         // write body
-        if(chunked_)
-            boost::asio::write(stream_,
+        if(wp_.chunked && last)
+        {
+            // write body and final chunk
+            wp_.last = true;
+            if(boost::asio::buffer_size(buffers) > 0)
+                write_buffers(stream_, buffer_cat(
+                    detail::chunk_encode(buffers),
+                        detail::chunk_encode_final()), ec_);
+            else
+                write_buffers(stream_,
+                    detail::chunk_encode_final(), ec_);
+        }
+        else if(wp_.chunked)
+            write_buffers(stream_,
                 detail::chunk_encode(buffers), ec_);
         else
-            boost::asio::write(stream_, buffers, ec_);
+            write_buffers(stream_, buffers, ec_);
+    }
+};
+
+// Blocks a synchronous write while the writer is suspended
+class sync_resume
+{
+    std::mutex m_;
+    std::condition_variable cv_;
+    bool ready_ = false;
+
+public:
+    // Called through the resume_context
+    void
+    resume()
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        ready_ = true;
+        cv_.notify_one();
+    }
+
+    void
+    wait()
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        cv_.wait(lock, [&]{ return ready_; });
+        ready_ = false;
     }
 };
 
+// Write the body using a writer which may suspend
+template<class SyncWriteStream, class WritePreparation>
+void
+write_body(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec, std::true_type)
+{
+    sync_resume sr;
+    boost::tribool result = wp.w(resume_context{sr},
+        ec, writef0_lambda<SyncWriteStream,
+            WritePreparation>{stream, wp, ec});
+    if(ec)
+        return;
+    if(boost::indeterminate(result))
+    {
+        sr.wait();
+        write_buffers(stream, wp.hb, ec);
+        if(ec)
+            return;
+        result = false;
+    }
+    if(! result)
+    {
+        for(;;)
+        {
+            result = wp.w(resume_context{sr}, ec,
+                writef_lambda<SyncWriteStream,
+                    WritePreparation>{stream, wp, ec});
+            if(ec)
+                return;
+            if(result)
+                break;
+            if(! result)
+                continue;
+            sr.wait();
+        }
+    }
+}
+
+// Write the body using a writer which never suspends
+template<class SyncWriteStream, class WritePreparation>
+void
+write_body(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec, std::false_type)
+{
+    bool result = wp.w(resume_context{}, ec,
+        writef0_lambda<SyncWriteStream,
+            WritePreparation>{stream, wp, ec});
+    while(! ec && ! result)
+        result = wp.w(resume_context{}, ec,
+            writef_lambda<SyncWriteStream,
+                WritePreparation>{stream, wp, ec});
+}
+
+// Send the body directly from the writer to the socket.
+// Returns `false` if the body must be written normally.
+template<class SyncWriteStream, class WritePreparation>
+bool
+transmit_body(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec, std::true_type)
+{
+    if(wp.chunked)
+        return false;
+    cork(stream.native_handle(), true);
+    write_buffers(stream, wp.hb, ec);
+    while(! ec)
+    {
+        auto const done = wp.w.transmit(
+            stream.native_handle(), ec);
+        if(ec == boost::asio::error::would_block ||
+            ec == boost::asio::error::try_again)
+        {
+            // wait until the socket is ready
+            ec = {};
+            stream.write_some(boost::asio::null_buffers{}, ec);
+        }
+        else if(done)
+            break;
+    }
+    cork(stream.native_handle(), false);
+    return true;
+}
+
+template<class SyncWriteStream, class WritePreparation>
+bool
+transmit_body(SyncWriteStream&,
+    WritePreparation&, error_code&, std::false_type)
+{
+    return false;
+}
+
 } // detail
 
 //------------------------------------------------------------------------------
@@ -472,63 +764,20 @@ write(SyncWriteStream& stream,
     wp.init(ec);
     if(ec)
         return;
-    std::mutex m;
-    std::condition_variable cv;
-    bool ready = false;
-    resume_context resume{
-        [&]
-        {
-            std::lock_guard<std::mutex> lock(m);
-            ready = true;
-            cv.notify_one();
-        }};
-    auto copy = resume;
-    boost::tribool result = wp.w(std::move(copy),
-        ec, detail::writef0_lambda<SyncWriteStream,
-            decltype(wp.sb)>{stream, wp.sb, wp.chunked, ec});
+    if(! detail::transmit_body(stream, wp, ec,
+        detail::can_transmit<SyncWriteStream,
+            typename Body::writer>{}))
+        detail::write_body(stream, wp, ec,
+            detail::writer_may_suspend<typename Body::writer>{});
     if(ec)
         return;
-    if(boost::indeterminate(result))
-    {
-        copy = resume;
-        {
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
-        }
-        boost::asio::write(stream, wp.sb.data(), ec);
-        if(ec)
-            return;
-        result = false;
-    }
-    wp.sb.consume(wp.sb.size());
-    if(! result)
-    {
-        for(;;)
-        {
-            result = wp.w(std::move(copy), ec,
-                detail::writef_lambda<SyncWriteStream>{
-                    stream, wp.chunked, ec});
-            if(ec)
-                return;
-            if(result)
-                break;
-            if(! result)
-                continue;
-            copy = resume;
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
-        }
-    }
-    if(wp.chunked)
+    if(wp.chunked && ! wp.last)
     {
-        // VFALCO Unfortunately the current interface to the
-        //        Writer concept prevents us from using coalescing the
-        //        final body chunk with the final chunk delimiter.
+        // The writer did not mark its last buffers,
+        // so the final chunk is sent separately.
         //
         // write final chunk
-        boost::asio::write(stream, detail::chunk_encode_final(), ec);
+        detail::write_buffers(stream, detail::chunk_encode_final(), ec);
         if(ec)
             return;
     }
@@ -0,0 +1,311 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_MMAP_BODY_HPP
+#define BEAST_HTTP_MMAP_BODY_HPP
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/detail/read_only_file.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace beast {
+namespace http {
+
+/** A Body represented by a read-only memory mapping of a file.
+
+    The body refers to a shared @ref mmap_body::mapping. Serializing
+    the message hands out buffers pointing directly into the mapped
+    file, so sending the same mapping repeatedly performs no reads
+    and no copies. A process-wide @ref mmap_body::cache keeps
+    mappings open between messages, reopening a file when it is
+    replaced or its size or modification time changes.
+
+    @note A file must not be truncated or rewritten in place while
+    it is mapped. Reading a page past the new end of a truncated file
+    raises `SIGBUS` in the thread sending the body, and a rewrite is
+    sent partly old and partly new. Update served files by writing
+    a new file and renaming it over the old path; existing mappings
+    keep the old contents, and the cache maps the new file. Use
+    @ref file_body for files which may be changed in place.
+
+    Example:
+    @code
+        error_code ec;
+        response_v1<mmap_body> res;
+        res.body = mmap_body::cache::instance().get("/var/www/index.html", ec);
+        if(! ec)
+        {
+            prepare(res);
+            write(sock, res);
+        }
+    @endcode
+
+    Meets the requirements of @b `Body`.
+*/
+struct mmap_body
+{
+    class cache;
+
+    /// A read-only memory mapping of an entire file.
+    class mapping
+    {
+        friend class cache;
+
+        boost::interprocess::mapped_region region_;
+        detail::file_status stamp_;
+
+    public:
+        mapping(mapping const&) = delete;
+        mapping& operator=(mapping const&) = delete;
+
+        /** Open and map a file.
+
+            @param path The path to the file.
+
+            @param ec Set to the error, if any occurred.
+
+            @return The mapping, or `nullptr` on error.
+        */
+        static
+        std::shared_ptr<mapping const>
+        open(std::string const& path, error_code& ec);
+
+        /// Returns a pointer to the contents of the file.
+        void const*
+        data() const
+        {
+            return region_.get_address();
+        }
+
+        /// Returns the size of the file.
+        std::uint64_t
+        size() const
+        {
+            return stamp_.size;
+        }
+
+        /// Returns the modification time of the file when mapped.
+        std::time_t
+        mtime() const
+        {
+            return stamp_.mtime;
+        }
+
+        /** Returns the nanoseconds part of the modification time.
+
+            This is zero on platforms which do not record it.
+        */
+        long
+        mtime_nsec() const
+        {
+            return stamp_.mtime_nsec;
+        }
+
+        /** Returns the inode number of the file when mapped.
+
+            This is zero on platforms which do not provide it.
+        */
+        std::uint64_t
+        inode() const
+        {
+            return stamp_.inode;
+        }
+
+    private:
+        mapping() = default;
+    };
+
+    /** A thread-safe cache of mappings, keyed by path.
+
+        A cached mapping is returned only if the file at the path
+        is the same file, identified by device and inode, with the
+        same size and modification time to the nanosecond where the
+        platform records it; otherwise the file is mapped again and
+        the cache updated. Mappings
+        remain valid while referenced by a message, even after
+        they are removed from the cache.
+    */
+    class cache
+    {
+        std::mutex m_;
+        std::unordered_map<std::string,
+            std::shared_ptr<mapping const>> map_;
+
+    public:
+        /// Returns the process-wide cache.
+        static
+        cache&
+        instance()
+        {
+            static cache c;
+            return c;
+        }
+
+        /** Return a mapping of the file, opening it if needed.
+
+            @param path The path to the file.
+
+            @param ec Set to the error, if any occurred.
+
+            @return The mapping, or `nullptr` on error.
+        */
+        std::shared_ptr<mapping const>
+        get(std::string const& path, error_code& ec);
+
+        /// Remove the mapping for a path, if any.
+        void
+        erase(std::string const& path)
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            map_.erase(path);
+        }
+
+        /// Remove all mappings.
+        void
+        clear()
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            map_.clear();
+        }
+
+        /// Returns the number of cached mappings.
+        std::size_t
+        size()
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            return map_.size();
+        }
+    };
+
+    /// The type of the `message::body` member
+    using value_type = std::shared_ptr<mapping const>;
+
+    /// Returns the number of octets in the body.
+    static
+    std::uint64_t
+    size(value_type const& body, error_code& ec)
+    {
+        if(! body)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::invalid_argument);
+            return 0;
+        }
+        return body->size();
+    }
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        explicit
+        writer(message<isRequest,
+                mmap_body, Headers> const& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code& ec)
+        {
+            if(! body_)
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::invalid_argument);
+        }
+
+        std::uint64_t
+        content_length() const
+        {
+            return body_ ? body_->size() : 0;
+        }
+
+        template<class Write>
+        bool
+        operator()(resume_context&&, error_code&, Write&& write)
+        {
+            write(boost::asio::buffer(body_->data(),
+                static_cast<std::size_t>(body_->size())), true);
+            return true;
+        }
+    };
+};
+
+inline
+auto
+mmap_body::mapping::open(
+    std::string const& path, error_code& ec) ->
+        std::shared_ptr<mapping const>
+{
+    using namespace boost::interprocess;
+    std::shared_ptr<mapping> m{new mapping};
+    detail::file_stamp(path.c_str(), m->stamp_, ec);
+    if(ec)
+        return nullptr;
+    // An empty file cannot be mapped
+    if(m->stamp_.size == 0)
+        return m;
+    try
+    {
+        file_mapping fm{path.c_str(), read_only};
+        mapped_region{fm, read_only, 0,
+            static_cast<std::size_t>(m->stamp_.size)}.swap(m->region_);
+    }
+    catch(interprocess_exception const& e)
+    {
+        ec = error_code{e.get_native_error(),
+            boost::system::system_category()};
+        return nullptr;
+    }
+    return m;
+}
+
+inline
+auto
+mmap_body::cache::get(
+    std::string const& path, error_code& ec) ->
+        std::shared_ptr<mapping const>
+{
+    detail::file_status fs;
+    detail::file_stamp(path.c_str(), fs, ec);
+    if(ec)
+        return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it != map_.end() && it->second->stamp_ == fs)
+            return it->second;
+    }
+    auto m = mapping::open(path, ec);
+    if(ec)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(m_);
+    map_[path] = m;
+    return m;
+}
+
+} // http
+} // beast
+
+#endif
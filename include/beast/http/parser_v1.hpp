@@ -12,6 +12,7 @@
 #include <beast/http/concepts.hpp>
 #include <beast/http/message_v1.hpp>
 #include <beast/core/error.hpp>
+#include <boost/assert.hpp>
 #include <functional>
 #include <string>
 #include <type_traits>
@@ -35,6 +36,9 @@ struct parser_response
 
 } // detail
 
+template<bool isRequest, class Headers>
+class header_parser_v1;
+
 /** Skip body option.
 
     The options controls whether or not the parser expects to see a
@@ -89,10 +93,13 @@ private:
     static_assert(is_ReadableBody<Body>::value,
         "ReadableBody requirements not met");
 
+    using reader_type =
+        typename message_type::body_type::reader;
+
     std::string field_;
     std::string value_;
     message_type m_;
-    typename message_type::body_type::reader r_;
+    reader_type r_;
     std::uint8_t skip_body_ = 0;
 
 public:
@@ -113,6 +120,29 @@ public:
     {
     }
 
+    /** Construct the parser from a header parser.
+
+        The start line and headers parsed by `parser` are moved
+        into the message, and parsing continues with the body from
+        where `parser` left off. The body reader is constructed
+        after the headers are moved, so it may inspect them.
+
+        @param parser The header parser, which should be complete.
+
+        @param args A list of arguments forwarded to the message constructor.
+    */
+    template<class... Args>
+    explicit
+    parser_v1(header_parser_v1<isRequest, Headers>&& parser,
+            Args&&... args)
+        : basic_parser_v1<isRequest, parser_v1>(parser)
+        , m_(std::forward<Args>(args)...)
+        , r_(assign(parser.get()))
+    {
+    }
+
+    using basic_parser_v1<isRequest, parser_v1>::set_option;
+
     /// Set the expect body option.
     void
     set_option(skip_body const& o)
@@ -156,9 +186,83 @@ public:
         return std::move(m_);
     }
 
+    /** Returns buffers for storing body octets directly.
+
+        This function is only available when the body's reader
+        provides the optional `prepare` and `commit` members. It
+        returns a mutable buffer sequence of size `n` referring to
+        the body storage, allowing a caller to read octets from a
+        stream directly into the body. The octets must then be
+        accounted for with a call to @ref commit_body.
+
+        @param n The number of octets to prepare. This must not
+        exceed the value returned by @ref body_remain.
+    */
+#if GENERATING_DOCS
+    implementation_defined
+    prepare_body(std::size_t n);
+#else
+    template<class Reader = reader_type>
+    auto
+    prepare_body(std::size_t n) ->
+        decltype(std::declval<Reader&>().prepare(n))
+    {
+        BOOST_ASSERT(n <= this->body_remain());
+        return r_.prepare(n);
+    }
+#endif
+
+    /** Commit body octets stored directly.
+
+        This makes the first `n` octets of the buffers returned by the
+        last call to @ref prepare_body part of the body. It must be
+        called once for each call to @ref prepare_body, even if no
+        octets were stored.
+
+        @param n The number of octets stored, which may be zero.
+
+        @param ec Set to the error, if any error occurred.
+    */
+#if GENERATING_DOCS
+    void
+    commit_body(std::size_t n, error_code& ec);
+#else
+    template<class Reader = reader_type>
+    auto
+    commit_body(std::size_t n, error_code& ec) ->
+        decltype(std::declval<Reader&>().commit(n))
+    {
+        r_.commit(n);
+        this->consume_body(n, ec);
+    }
+#endif
+
 private:
     friend class basic_parser_v1<isRequest, parser_v1>;
 
+    template<class Message>
+    void assign(Message& m, std::true_type)
+    {
+        m_.method = std::move(m.method);
+        m_.url = std::move(m.url);
+    }
+
+    template<class Message>
+    void assign(Message& m, std::false_type)
+    {
+        m_.status = m.status;
+        m_.reason = std::move(m.reason);
+    }
+
+    template<class Message>
+    message_type& assign(Message& m)
+    {
+        assign(m, std::integral_constant<bool, isRequest>{});
+        m_.version = m.version;
+        m_.headers = std::move(m.headers);
+        return m_;
+    }
+
     void flush()
     {
         if(! value_.empty())
@@ -237,6 +341,8 @@ private:
 
     void on_complete(error_code&)
     {
+        // Insert the last trailer field, if any
+        flush();
     }
 };
 
@@ -12,6 +12,7 @@
 #include <beast/core/error.hpp>
 #include <beast/core/async_completion.hpp>
 #include <boost/asio/buffer.hpp>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -26,12 +27,21 @@ namespace http {
 
     @li An error occurs in the stream or parser.
 
+    If the parser is already complete on entry, the function
+    returns immediately.
+
     This function is implemented in terms of one or more calls
     to the stream's `read_some` function. The implementation may
     read additional octets that lie past the end of the message
     being parsed. This additional data is stored in the stream
     buffer, which may be used in subsequent calls.
 
+    When the parser provides `prepare_body` and `commit_body`, as
+    @ref parser_v1 does for bodies whose reader supports it, the
+    octets of a body with a known Content-Length are read from the
+    stream directly into the body once the stream buffer is empty,
+    instead of being copied through the stream buffer.
+
     @param stream The stream from which the data is to be read.
     The type must support the @b `SyncReadStream` concept.
 
@@ -61,12 +71,21 @@ parse(SyncReadStream& stream,
 
     @li An error occurs in the stream or parser.
 
+    If the parser is already complete on entry, the function
+    returns immediately.
+
     This function is implemented in terms of one or more calls
     to the stream's `read_some` function. The implementation may
     read additional octets that lie past the end of the message
     being parsed. This additional data is stored in the stream
     buffer, which may be used in subsequent calls.
 
+    When the parser provides `prepare_body` and `commit_body`, as
+    @ref parser_v1 does for bodies whose reader supports it, the
+    octets of a body with a known Content-Length are read from the
+    stream directly into the body once the stream buffer is empty,
+    instead of being copied through the stream buffer.
+
     @param stream The stream from which the data is to be read.
     The type must support the @b `SyncReadStream` concept.
 
@@ -97,11 +116,20 @@ parse(SyncReadStream& stream,
 
     @li An error occurs in the stream or parser.
 
+    If the parser is already complete on entry, the operation
+    completes without reading.
+
     This operation is implemented in terms of one or more calls to
     the next layer's `async_read_some` function, and is known as a
     <em>composed operation</em>. The program must ensure that the
     stream performs no other operations until this operation completes.
 
+    When the parser provides `prepare_body` and `commit_body`, as
+    @ref parser_v1 does for bodies whose reader supports it, the
+    octets of a body with a known Content-Length are read from the
+    stream directly into the body once the stream buffer is empty,
+    instead of being copied through the stream buffer.
+
     @param stream The stream from which the data is to be read.
     The type must support the @b `AsyncReadStream` concept.
 
@@ -261,6 +289,148 @@ async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
     message_v1<isRequest, Body, Headers>& msg,
         ReadHandler&& handler);
 
+/** Read all pipelined HTTP/1 messages available from a stream.
+
+    This function is used to synchronously read a batch of messages
+    from the stream. The call blocks until one of the following
+    conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    After the first message is complete, every additional complete
+    message already present in the stream buffer is parsed without
+    performing further reads. The messages are appended to `msgs`
+    in the order they were received. An incomplete trailing message
+    is left in the stream buffer, to be finished by subsequent calls.
+    No further messages are parsed after one which indicates that the
+    connection should be closed or upgraded.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which each message is appended.
+
+    @throws boost::system::system_error Thrown on failure.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs);
+
+/** Read all pipelined HTTP/1 messages available from a stream.
+
+    This function is used to synchronously read a batch of messages
+    from the stream. The call blocks until one of the following
+    conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    After the first message is complete, every additional complete
+    message already present in the stream buffer is parsed without
+    performing further reads. The messages are appended to `msgs`
+    in the order they were received. An incomplete trailing message
+    is left in the stream buffer, to be finished by subsequent calls.
+    No further messages are parsed after one which indicates that the
+    connection should be closed or upgraded.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which each message is appended.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec);
+
+/** Start an asynchronous operation to read all pipelined HTTP/1 messages.
+
+    This function is used to asynchronously read a batch of messages
+    from the stream. The function call always returns immediately. The
+    asynchronous operation will continue until one of the following
+    conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    After the first message is complete, every additional complete
+    message already present in the stream buffer is parsed without
+    performing further reads. The messages are appended to `msgs`
+    in the order they were received. An incomplete trailing message
+    is left in the stream buffer, to be finished by subsequent calls.
+    No further messages are parsed after one which indicates that the
+    connection should be closed or upgraded.
+
+    This operation is implemented in terms of one or more calls to the
+    next layer's `async_read_some` function, and is known as a
+    <em>composed operation</em>. The program must ensure that the stream
+    performs no other operations until this operation completes.
+
+    @param stream The stream to read the messages from.
+    The type must support the @b `AsyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which each message is appended.
+    This object must remain valid until the completion handler
+    is invoked.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_read_pipelined(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message_v1<isRequest, Body, Headers>, Allocator>& msgs,
+        ReadHandler&& handler);
+
 } // http
 } // beast
 
@@ -8,7 +8,8 @@
 #ifndef BEAST_HTTP_RESUME_CONTEXT_HPP
 #define BEAST_HTTP_RESUME_CONTEXT_HPP
 
-#include <functional>
+#include <boost/assert.hpp>
+#include <type_traits>
 
 namespace beast {
 namespace http {
@@ -25,8 +26,103 @@ namespace http {
     to indicate that the write operation should suspend. Later, the calling
     code invokes the resume function and the write operation continues
     from where it left off.
+
+    The resume context is a small handle referring to the suspended
+    operation, which keeps the state needed to continue. Constructing,
+    copying, and invoking a resume context never allocates memory.
+    The context must be invoked exactly once for each suspension;
+    copies refer to the same operation. The context does not own the
+    operation: the suspended operation keeps itself alive until it is
+    resumed, so if the context is never invoked, the operation and its
+    completion handler are leaked.
 */
-using resume_context = std::function<void(void)>;
+class resume_context
+{
+    void* p_ = nullptr;
+    void(*f_)(void*) = nullptr;
+
+    template<class T>
+    static
+    void
+    call(void* p)
+    {
+        static_cast<T*>(p)->resume();
+    }
+
+public:
+    /// Default constructor, creating an empty context.
+    resume_context() = default;
+
+    /// Copy constructor
+    resume_context(resume_context const&) = default;
+
+    /// Copy assignment
+    resume_context& operator=(resume_context const&) = default;
+
+    /** Move constructor.
+
+        After the move, `other` is empty.
+    */
+    resume_context(resume_context&& other)
+        : p_(other.p_)
+        , f_(other.f_)
+    {
+        other.p_ = nullptr;
+        other.f_ = nullptr;
+    }
+
+    /** Move assignment.
+
+        After the move, `other` is empty.
+    */
+    resume_context&
+    operator=(resume_context&& other)
+    {
+        p_ = other.p_;
+        f_ = other.f_;
+        other.p_ = nullptr;
+        other.f_ = nullptr;
+        return *this;
+    }
+
+    /** Construct a context referring to a pending operation.
+
+        Invoking the context calls `op.resume()`. The object
+        `op` must remain valid until the context is invoked.
+
+        @param op The pending operation.
+    */
+#if GENERATING_DOCS
+    template<class Operation>
+#else
+    template<class Operation, class = typename std::enable_if<
+        ! std::is_same<Operation, resume_context>::value>::type>
+#endif
+    explicit
+    resume_context(Operation& op)
+        : p_(&op)
+        , f_(&resume_context::call<Operation>)
+    {
+    }
+
+    /// Returns `true` if the context refers to an operation.
+    explicit
+    operator bool() const
+    {
+        return f_ != nullptr;
+    }
+
+    /** Resume the write operation.
+
+        The context must not be empty.
+    */
+    void
+    operator()() const
+    {
+        BOOST_ASSERT(f_);
+        f_(p_);
+    }
+};
 
 } // http
 } // beast
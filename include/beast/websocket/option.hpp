@@ -303,6 +303,41 @@ struct read_buffer_size
 };
 #endif
 
+/** Vectored read option.
+
+    Determines if a read which finds the read buffer empty fills the
+    caller's buffers and the read buffer in a single read on the next
+    layer. Frame payloads are then received without a copy, while the
+    header of the following frame usually arrives in the read buffer
+    with the same system call. This has no effect when the read buffer
+    size is zero.
+
+    The default is to read into the read buffer only, and copy out.
+
+    @note Objects of this type are passed to @ref stream::set_option.
+
+    @par Example
+    Enabling vectored reads.
+    @code
+    ...
+    websocket::stream<ip::tcp::socket> ws(ios);
+    ws.set_option(read_buffer_size{16 * 1024}, read_buffer_vectored{true});
+    @endcode
+*/
+#if GENERATING_DOCS
+using read_buffer_vectored = implementation_defined;
+#else
+struct read_buffer_vectored
+{
+    bool value;
+
+    read_buffer_vectored(bool v)
+        : value(v)
+    {
+    }
+};
+#endif
+
 /** Maximum incoming message size option.
 
     Sets the largest permissible incoming message size. Message
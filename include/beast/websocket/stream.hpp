@@ -232,6 +232,13 @@ public:
         stream_.capacity(o.value);
     }
 
+    /// Set the vectored read option
+    void
+    set_option(read_buffer_vectored const& o)
+    {
+        stream_.vectored(o.value);
+    }
+
     /// Set the maximum incoming message size allowed
     void
     set_option(read_message_max const& o)
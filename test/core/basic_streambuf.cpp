@@ -25,6 +25,8 @@ struct test_allocator_info
     std::size_t ncopy = 0;
     std::size_t nmove = 0;
     std::size_t nselect = 0;
+    std::size_t nalloc = 0;
+    std::size_t ndealloc = 0;
 };
 
 template<class T,
@@ -114,6 +116,7 @@ public:
     value_type*
     allocate(std::size_t n)
     {
+        ++info_->nalloc;
         return static_cast<value_type*>(
             ::operator new (n*sizeof(value_type)));
     }
@@ -121,6 +124,7 @@ public:
     void
     deallocate(value_type* p, std::size_t) noexcept
     {
+        ++info_->ndealloc;
         ::operator delete(p);
     }
 
@@ -390,6 +394,54 @@ public:
         BEAST_EXPECT(test::buffer_count(sb.data()) == 4);
     }
 
+    void
+    testRecycle()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        using alloc_type =
+            test_allocator<char, false, false, false, false>;
+        using sb_type = basic_streambuf<alloc_type>;
+        std::string const s(300, '*');
+
+        // Like a parser, consume all but a few bytes after
+        // each read, so the input moves across buffers.
+        auto const stream =
+            [&](sb_type& sb, std::size_t rounds)
+            {
+                for(std::size_t i = 0; i < rounds; ++i)
+                {
+                    sb.commit(buffer_copy(
+                        sb.prepare(s.size()), buffer(s)));
+                    sb.consume(sb.size() - 50);
+                }
+            };
+        alloc_type a;
+        {
+            sb_type sb(1024, a);
+            stream(sb, 10);
+            auto const n = a->nalloc;
+            stream(sb, 1000);
+            BEAST_EXPECT(a->nalloc == n);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(0, 50));
+
+            // Without a free list, buffers are allocated all along
+            sb.set_max_free(0);
+            BEAST_EXPECT(a->ndealloc > 0);
+            stream(sb, 1000);
+            BEAST_EXPECT(a->nalloc > n);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(0, 50));
+
+            sb.set_max_free(2);
+            stream(sb, 10);
+            sb_type sb2(std::move(sb));
+            auto const n2 = a->nalloc;
+            stream(sb2, 1000);
+            BEAST_EXPECT(a->nalloc == n2);
+        }
+        BEAST_EXPECT(a->nalloc == a->ndealloc);
+    }
+
     void testOutputStream()
     {
         streambuf sb;
@@ -443,6 +495,83 @@ public:
         }
     }
 
+    void testAdaptiveReadSize()
+    {
+        using boost::asio::buffer_size;
+        streambuf sb;
+        // Reads which return the given number of bytes
+        auto const read =
+            [&](std::size_t bytes)
+            {
+                auto const n = read_size_helper(sb, 65536);
+                sb.commit(std::min(bytes, buffer_size(sb.prepare(n))));
+                sb.consume(sb.size());
+                return n;
+            };
+        BEAST_EXPECT(read(65536) == 1024);
+        BEAST_EXPECT(read(65536) == 2048);
+        BEAST_EXPECT(read(65536) == 4096);
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < 10; ++i)
+            n = read(65536);
+        BEAST_EXPECT(n == 65536);
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 1000);
+        // Short reads bring the size back down
+        BEAST_EXPECT(read(100) == 65536);
+        BEAST_EXPECT(read(100) == 32768);
+        for(std::size_t i = 0; i < 10; ++i)
+            n = read(100);
+        BEAST_EXPECT(n <= 1024);
+        BEAST_EXPECT(sb.capacity() <= 1024);
+        // Reads filling more than half keep the size
+        for(std::size_t i = 0; i < 10; ++i)
+            read(65536);
+        for(std::size_t i = 0; i < 10; ++i)
+            n = read(40000);
+        BEAST_EXPECT(n == 65536);
+        // Copies and moves keep the adapted size
+        {
+            streambuf sb2(sb);
+            BEAST_EXPECT(read_size_helper(sb2, 65536) == 65536);
+            streambuf sb3;
+            sb3 = sb;
+            BEAST_EXPECT(read_size_helper(sb3, 65536) == 65536);
+            basic_streambuf<test_allocator<char, true, true, true, true>>
+                sb4(sb);
+            BEAST_EXPECT(read_size_helper(sb4, 65536) == 65536);
+            streambuf sb5(std::move(sb2));
+            BEAST_EXPECT(read_size_helper(sb5, 65536) == 65536);
+            sb5 = std::move(sb3);
+            BEAST_EXPECT(read_size_helper(sb5, 65536) == 65536);
+        }
+        // Writing into the buffer is not a read
+        {
+            using boost::asio::buffer;
+            using boost::asio::buffer_copy;
+            std::string const s(4096, '*');
+            streambuf sb2;
+            for(std::size_t i = 0; i < 10; ++i)
+            {
+                sb2.commit(buffer_copy(
+                    sb2.prepare(s.size()), buffer(s)));
+                sb2 << s;
+            }
+            streambuf sb3(sb2);
+            sb3.consume(sb3.size());
+            BEAST_EXPECT(read_size_helper(sb3, 65536) < 65536);
+            sb2.consume(sb2.size());
+            BEAST_EXPECT(read_size_helper(sb2, 65536) < 65536);
+            // Short writes do not shrink the read size
+            for(std::size_t i = 0; i < 10; ++i)
+            {
+                sb.commit(buffer_copy(
+                    sb.prepare(s.size()), buffer(s.data(), 100)));
+                sb.consume(sb.size());
+            }
+            BEAST_EXPECT(read_size_helper(sb, 65536) == 65536);
+        }
+    }
+
     void run() override
     {
         testSpecialMembers();
@@ -452,8 +581,10 @@ public:
         testConsume();
         testMatrix();
         testIterators();
+        testRecycle();
         testOutputStream();
         testReadSizeHelper();
+        testAdaptiveReadSize();
     }
 };
 
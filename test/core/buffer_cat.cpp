@@ -11,8 +11,10 @@
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/streambuf.hpp>
+#include <array>
 #include <iterator>
 #include <list>
+#include <type_traits>
 #include <vector>
 
 namespace beast {
@@ -139,10 +141,82 @@ public:
         BEAST_EXPECT(it == it2);
     }
 
+    void testRandomAccess()
+    {
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        char buf[9] = {};
+        std::vector<const_buffer> b1{
+            const_buffer{buf+0, 1},
+            const_buffer{buf+1, 2}};
+        std::vector<const_buffer> b2;
+        std::array<const_buffer, 3> b3{{
+            const_buffer{buf+3, 1},
+            const_buffer{buf+4, 2},
+            const_buffer{buf+6, 3}}};
+        auto bs = buffer_cat(b1, b2, b3);
+        using iterator = decltype(bs)::const_iterator;
+        BEAST_EXPECT((std::is_same<std::iterator_traits<
+            iterator>::iterator_category,
+                std::random_access_iterator_tag>::value));
+        BEAST_EXPECT(bs.end() - bs.begin() == 5);
+        for(int i = 0; i < 5; ++i)
+        {
+            auto it = bs.begin() + i;
+            BEAST_EXPECT(it - bs.begin() == i);
+            BEAST_EXPECT(std::next(bs.begin(), i) == it);
+            BEAST_EXPECT(buffer_size(bs.begin()[i]) ==
+                buffer_size(*it));
+            BEAST_EXPECT(bs.end() - (5 - i) == it);
+            BEAST_EXPECT(it < bs.end());
+            BEAST_EXPECT(it >= bs.begin());
+        }
+        BEAST_EXPECT(buffer_size(bs.begin()[4]) == 3);
+        try
+        {
+            bs.begin() + 6;
+            fail();
+        }
+        catch(std::exception const&)
+        {
+            pass();
+        }
+        // A list makes the iterator bidirectional
+        std::list<const_buffer> b4;
+        using iterator2 = decltype(
+            buffer_cat(b1, b4))::const_iterator;
+        BEAST_EXPECT((std::is_same<std::iterator_traits<
+            iterator2>::iterator_category,
+                std::bidirectional_iterator_tag>::value));
+    }
+
+    void testFlatten()
+    {
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        using boost::asio::const_buffers_1;
+        char buf[6] = {};
+        const_buffers_1 b1{buf+0, 1};
+        const_buffers_1 b2{buf+1, 2};
+        std::array<const_buffer, 1> b3{{const_buffer{buf+3, 3}}};
+        auto bs = buffer_cat(buffer_cat(b1, b2), b3);
+        BEAST_EXPECT((std::is_same<decltype(bs),
+            decltype(buffer_cat(b1, b2, b3))>::value));
+        BEAST_EXPECT((std::is_same<decltype(bs),
+            decltype(buffer_cat(b1, buffer_cat(b2, b3)))>::value));
+        BEAST_EXPECT(buffer_size(bs) == 6);
+        BEAST_EXPECT(std::distance(bs.begin(), bs.end()) == 3);
+        auto bs2 = buffer_cat(bs, buffer_cat(b1, b2));
+        BEAST_EXPECT(buffer_size(bs2) == 9);
+        BEAST_EXPECT(std::distance(bs2.begin(), bs2.end()) == 5);
+    }
+
     void run() override
     {
         testBufferCat();
         testIterators();
+        testRandomAccess();
+        testFlatten();
     }
 };
 
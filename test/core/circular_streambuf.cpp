@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/circular_streambuf.hpp>
+
+#ifndef _WIN32
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<circular_streambuf>::value, "");
+
+class circular_streambuf_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::size_t
+    page_size()
+    {
+        return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    }
+
+    template<class DynamicBuffer>
+    static
+    void
+    append(DynamicBuffer& db, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        db.commit(buffer_copy(db.prepare(s.size()), buffer(s)));
+    }
+
+    void
+    testMirror()
+    {
+        using boost::asio::buffer_size;
+        auto const page = page_size();
+        circular_streambuf sb(1);
+        BEAST_EXPECT(sb.capacity() == 0);
+        BEAST_EXPECT(buffer_size(sb.data()) == 0);
+        std::string s;
+        for(std::size_t i = 0; i < page; ++i)
+            s.push_back(static_cast<char>('a' + i % 26));
+        // Move the input sequence around the ring
+        // several times, at sizes which wrap.
+        std::string expected;
+        for(std::size_t i = 0; i < 50; ++i)
+        {
+            auto const n = (i * 997) % page;
+            auto const t = s.substr(0, page - n);
+            if(sb.size() + t.size() > page)
+            {
+                expected.erase(0, sb.size() + t.size() - page);
+                sb.consume(sb.size() + t.size() - page);
+            }
+            append(sb, t);
+            expected += t;
+            BEAST_EXPECT(sb.capacity() == page);
+            BEAST_EXPECT(buffer_size(sb.data()) == expected.size());
+            BEAST_EXPECT(to_string(sb.data()) == expected);
+            auto const d = sb.prepare(page - sb.size());
+            BEAST_EXPECT(buffer_size(d) == page - sb.size());
+        }
+        sb.consume(sb.size());
+        BEAST_EXPECT(sb.size() == 0);
+        BEAST_EXPECT(to_string(sb.data()).empty());
+    }
+
+    void
+    testGrow()
+    {
+        auto const page = page_size();
+        {
+            circular_streambuf sb(1);
+            std::string expected;
+            append(sb, std::string(page / 2, '.'));
+            sb.consume(page / 2 - 1);
+            expected = ".";
+            for(std::size_t i = 0; i < 5; ++i)
+            {
+                auto const t = std::string(page, static_cast<char>('a' + i));
+                append(sb, t);
+                expected += t;
+            }
+            BEAST_EXPECT(sb.size() == expected.size());
+            BEAST_EXPECT(sb.capacity() >= sb.size());
+            BEAST_EXPECT(sb.capacity() % page == 0);
+            BEAST_EXPECT(to_string(sb.data()) == expected);
+        }
+        {
+            circular_streambuf sb(1, page + 1);
+            BEAST_EXPECT(sb.max_size() == page + 1);
+            append(sb, std::string(page, '*'));
+            sb.prepare(1);
+            try
+            {
+                sb.prepare(2);
+                fail();
+            }
+            catch(std::length_error const&)
+            {
+                pass();
+            }
+            BEAST_EXPECT(to_string(sb.data()) == std::string(page, '*'));
+        }
+    }
+
+    void
+    testMove()
+    {
+        circular_streambuf sb1;
+        append(sb1, "Hello, world");
+        sb1.consume(7);
+        circular_streambuf sb2(std::move(sb1));
+        BEAST_EXPECT(sb1.size() == 0);
+        BEAST_EXPECT(sb1.capacity() == 0);
+        BEAST_EXPECT(to_string(sb2.data()) == "world");
+        circular_streambuf sb3;
+        append(sb3, "*");
+        sb3 = std::move(sb2);
+        BEAST_EXPECT(sb2.size() == 0);
+        BEAST_EXPECT(to_string(sb3.data()) == "world");
+        append(sb1, "!");
+        BEAST_EXPECT(to_string(sb1.data()) == "!");
+    }
+
+    void
+    testReadSizeHelper()
+    {
+        auto const page = page_size();
+        circular_streambuf sb(page);
+        BEAST_EXPECT(read_size_helper(sb, 0) == 0);
+        BEAST_EXPECT(read_size_helper(sb, 1) == 1);
+        BEAST_EXPECT(read_size_helper(sb, 2 * page) == page);
+        append(sb, "***");
+        BEAST_EXPECT(read_size_helper(sb, 2 * page) == page - 3);
+        append(sb, std::string(page - 3, '*'));
+        BEAST_EXPECT(read_size_helper(sb, 4 * page) == page);
+        sb.consume(page);
+        BEAST_EXPECT(read_size_helper(sb, 4 * page) == page);
+    }
+
+    void run() override
+    {
+        testMirror();
+        testGrow();
+        testMove();
+        testReadSizeHelper();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(circular_streambuf,core,beast);
+
+} // beast
+
+#endif
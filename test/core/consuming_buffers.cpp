@@ -12,7 +12,10 @@
 #include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/buffer.hpp>
+#include <array>
+#include <iterator>
 #include <string>
+#include <type_traits>
 
 namespace beast {
 
@@ -104,11 +107,38 @@ public:
         BEAST_EXPECT(n == 3);
     }
 
+    void testRandomAccess()
+    {
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        char buf[6] = {};
+        std::array<const_buffer, 3> ba{{
+            const_buffer{buf+0, 1},
+            const_buffer{buf+1, 2},
+            const_buffer{buf+3, 3}}};
+        consuming_buffers<decltype(ba)> cb(ba);
+        using iterator = decltype(cb)::const_iterator;
+        BEAST_EXPECT((std::is_same<std::iterator_traits<
+            iterator>::iterator_category,
+                std::random_access_iterator_tag>::value));
+        cb.consume(2);
+        BEAST_EXPECT(cb.end() - cb.begin() == 2);
+        BEAST_EXPECT(buffer_size(cb.begin()[0]) == 1);
+        BEAST_EXPECT(buffer_size(cb.begin()[1]) == 3);
+        BEAST_EXPECT(cb.begin() + 2 == cb.end());
+        BEAST_EXPECT(cb.end() - 1 == std::next(cb.begin()));
+        BEAST_EXPECT(cb.begin() < cb.end());
+        BEAST_EXPECT(buffer_size(cb) == 4);
+        auto const cb2 = cb;
+        BEAST_EXPECT(buffer_size(cb2) == 4);
+    }
+
     void run() override
     {
         testMatrix();
         testNullBuffers();
         testIterator();
+        testRandomAccess();
     }
 };
 
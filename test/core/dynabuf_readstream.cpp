@@ -9,6 +9,7 @@
 #include <beast/core/dynabuf_readstream.hpp>
 
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -24,6 +25,44 @@ class dynabuf_readstream_test
     using self = dynabuf_readstream_test;
 
 public:
+    // Counts the reads made on the next layer
+    class counting_stream
+    {
+        test::string_stream& next_;
+
+    public:
+        std::size_t reads = 0;
+
+        explicit
+        counting_stream(test::string_stream& next)
+            : next_(next)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return next_.get_io_service();
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers)
+        {
+            ++reads;
+            return next_.read_some(buffers);
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            ++reads;
+            return next_.read_some(buffers, ec);
+        }
+    };
+
     void testSpecialMembers()
     {
         using socket_type = boost::asio::ip::tcp::socket;
@@ -128,12 +167,115 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    void testVectored(yield_context do_yield)
+    {
+        using boost::asio::buffer;
+        std::string s;
+        s.resize(5);
+
+        {
+            test::string_stream ss(ios_, "Hello, world!");
+            dynabuf_readstream<
+                test::string_stream&, streambuf> srs(ss);
+            srs.capacity(64);
+            srs.vectored(true);
+            auto const n = srs.read_some(buffer(&s[0], s.size()));
+            BEAST_EXPECT(n == 5);
+            BEAST_EXPECT(s == "Hello");
+            BEAST_EXPECT(to_string(srs.buffer().data()) == ", world!");
+            s.resize(8);
+            BEAST_EXPECT(srs.read_some(buffer(&s[0], s.size())) == 8);
+            BEAST_EXPECT(s == ", world!");
+            BEAST_EXPECT(srs.buffer().size() == 0);
+        }
+        {
+            test::string_stream ss(ios_, "Hello");
+            dynabuf_readstream<
+                test::string_stream&, streambuf> srs(ss);
+            srs.capacity(64);
+            srs.vectored(true);
+            s.resize(13);
+            auto const n = srs.read_some(buffer(&s[0], s.size()));
+            BEAST_EXPECT(n == 5);
+            BEAST_EXPECT(s.substr(0, n) == "Hello");
+            BEAST_EXPECT(srs.buffer().size() == 0);
+        }
+        {
+            test::string_stream ss(ios_, "Hello, world!");
+            dynabuf_readstream<
+                test::string_stream&, streambuf> srs(ss);
+            srs.capacity(64);
+            srs.vectored(true);
+            s.resize(5);
+            error_code ec;
+            auto const n = srs.async_read_some(
+                buffer(&s[0], s.size()), do_yield[ec]);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(n == 5);
+            BEAST_EXPECT(s == "Hello");
+            BEAST_EXPECT(to_string(srs.buffer().data()) == ", world!");
+        }
+    }
+
+    // Reads frames made of a two digit header holding the payload
+    // size followed by the payload, as a WebSocket reader would,
+    // and returns the number of reads made on the next layer.
+    std::size_t
+    readFrames(std::string const& data,
+        std::size_t frames, bool vectored)
+    {
+        using boost::asio::buffer;
+        test::string_stream ss(ios_, data);
+        counting_stream cs(ss);
+        dynabuf_readstream<counting_stream&, streambuf> srs(cs);
+        srs.capacity(64);
+        srs.vectored(vectored);
+        std::string h(2, 0);
+        std::string payload;
+        std::size_t n = 0;
+        error_code ec;
+        for(;;)
+        {
+            boost::asio::read(srs, buffer(&h[0], h.size()), ec);
+            if(ec)
+                break;
+            payload.resize(std::stoul(h));
+            boost::asio::read(srs,
+                buffer(&payload[0], payload.size()), ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            BEAST_EXPECT(payload ==
+                std::string(payload.size(), 'a' + n++));
+        }
+        BEAST_EXPECT(ec == boost::asio::error::eof);
+        BEAST_EXPECT(n == frames);
+        return cs.reads;
+    }
+
+    void testVectoredFrames()
+    {
+        std::string data;
+        for(std::size_t i = 0; i < 4; ++i)
+            data += "99" + std::string(99, 'a' + i);
+        data += "05eeeee";
+        auto const copied = readFrames(data, 5, false);
+        auto const vectored = readFrames(data, 5, true);
+        // The payload goes straight to the caller, and the
+        // next header arrives with it in the same read.
+        BEAST_EXPECT(vectored < copied);
+        BEAST_EXPECT(vectored == 6);
+    }
+
     void run() override
     {
         testSpecialMembers();
 
         yield_to(std::bind(&self::testRead,
             this, std::placeholders::_1));
+        yield_to(std::bind(&self::testVectored,
+            this, std::placeholders::_1));
+        testVectoredFrames();
     }
 };
 
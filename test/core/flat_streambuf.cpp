@@ -0,0 +1,313 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/flat_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<flat_streambuf>::value, "");
+
+class flat_streambuf_test : public beast::unit_test::suite
+{
+public:
+    // Counts the allocations made through copies of itself
+    template<class T>
+    class counting_allocator
+    {
+        template<class>
+        friend class counting_allocator;
+
+        std::shared_ptr<std::size_t> n_;
+
+    public:
+        using value_type = T;
+
+        counting_allocator()
+            : n_(std::make_shared<std::size_t>(0))
+        {
+        }
+
+        template<class U>
+        counting_allocator(counting_allocator<U> const& other)
+            : n_(other.n_)
+        {
+        }
+
+        value_type*
+        allocate(std::size_t n)
+        {
+            ++*n_;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void
+        deallocate(value_type* p, std::size_t n)
+        {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        std::size_t
+        count() const
+        {
+            return *n_;
+        }
+
+        std::size_t const*
+        counter() const
+        {
+            return n_.get();
+        }
+
+        template<class U>
+        friend
+        bool
+        operator==(counting_allocator const& lhs,
+            counting_allocator<U> const& rhs)
+        {
+            return lhs.counter() == rhs.counter();
+        }
+
+        template<class U>
+        friend
+        bool
+        operator!=(counting_allocator const& lhs,
+            counting_allocator<U> const& rhs)
+        {
+            return ! (lhs == rhs);
+        }
+    };
+
+    template<class DynamicBuffer>
+    static
+    void
+    append(DynamicBuffer& db, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        db.commit(buffer_copy(db.prepare(s.size()), buffer(s)));
+    }
+
+    void
+    testMatrix()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        using boost::asio::buffer_size;
+        std::string const s = "Hello, world";
+        BEAST_EXPECT(s.size() == 12);
+        for(std::size_t i = 1; i < 12; ++i) {
+        for(std::size_t x = 1; x < 4; ++x) {
+        for(std::size_t y = 1; y < 4; ++y) {
+        for(std::size_t t = 1; t < 4; ++ t) {
+        for(std::size_t u = 1; u < 4; ++ u) {
+        std::size_t z = s.size() - (x + y);
+        std::size_t v = s.size() - (t + u);
+        {
+            flat_streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(x), buffer(s.data(), x)));
+            sb.commit(buffer_copy(sb.prepare(y), buffer(s.data()+x, y)));
+            sb.commit(buffer_copy(sb.prepare(z), buffer(s.data()+x+y, z)));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            {
+                flat_streambuf sb2(sb);
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+                flat_streambuf sb3(std::move(sb2));
+                BEAST_EXPECT(to_string(sb3.data()) == s);
+                BEAST_EXPECT(buffer_size(sb2.data()) == 0);
+                sb2 = sb3;
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+            }
+            sb.consume(t);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(t));
+            sb.consume(u);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(t + u));
+            sb.commit(buffer_copy(sb.prepare(i), buffer(s.data(), i)));
+            BEAST_EXPECT(to_string(sb.data()) ==
+                s.substr(t + u) + s.substr(0, i));
+            sb.consume(v);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(0, i));
+            sb.consume(i);
+            BEAST_EXPECT(sb.size() == 0);
+            BEAST_EXPECT(buffer_size(sb.data()) == 0);
+        }
+        }}}}}
+    }
+
+    void
+    testCompact()
+    {
+        using boost::asio::buffer_cast;
+        {
+            // More consumed than remains: the input moves to the front
+            flat_streambuf sb;
+            sb.reserve(100);
+            append(sb, std::string(90, '*'));
+            sb.consume(60);
+            auto const p = buffer_cast<char const*>(sb.prepare(0));
+            append(sb, std::string(40, '.'));
+            BEAST_EXPECT(sb.capacity() == 100);
+            BEAST_EXPECT(buffer_cast<char const*>(sb.data()) == p - 90);
+            BEAST_EXPECT(to_string(sb.data()) ==
+                std::string(30, '*') + std::string(40, '.'));
+        }
+        {
+            // Less consumed than remains: the array grows instead
+            flat_streambuf sb;
+            sb.reserve(100);
+            append(sb, std::string(90, '*'));
+            sb.consume(30);
+            append(sb, std::string(20, '.'));
+            BEAST_EXPECT(sb.capacity() == 200);
+            BEAST_EXPECT(to_string(sb.data()) ==
+                std::string(60, '*') + std::string(20, '.'));
+        }
+        {
+            // Consuming everything starts over at the front
+            flat_streambuf sb;
+            sb.reserve(100);
+            append(sb, std::string(90, '*'));
+            auto const p = buffer_cast<char const*>(sb.data());
+            sb.consume(90);
+            append(sb, std::string(100, '.'));
+            BEAST_EXPECT(sb.capacity() == 100);
+            BEAST_EXPECT(buffer_cast<char const*>(sb.data()) == p);
+        }
+        {
+            // A steady stream settles into a fixed capacity
+            counting_allocator<char> alloc;
+            basic_flat_streambuf<counting_allocator<char>> sb(
+                std::numeric_limits<std::size_t>::max(), alloc);
+            for(std::size_t i = 0; i < 1000; ++i)
+            {
+                append(sb, std::string(300, '*'));
+                sb.consume(sb.size() - 50);
+            }
+            BEAST_EXPECT(alloc.count() < 5);
+            BEAST_EXPECT(sb.capacity() < 1024);
+        }
+    }
+
+    void
+    testMaxSize()
+    {
+        flat_streambuf sb(100);
+        BEAST_EXPECT(sb.max_size() == 100);
+        append(sb, std::string(60, '*'));
+        sb.prepare(40);
+        // Growth stops at the maximum
+        BEAST_EXPECT(sb.capacity() == 100);
+        try
+        {
+            sb.prepare(41);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        try
+        {
+            sb.reserve(101);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(to_string(sb.data()) == std::string(60, '*'));
+        sb.consume(20);
+        append(sb, std::string(60, '.'));
+        BEAST_EXPECT(to_string(sb.data()) ==
+            std::string(40, '*') + std::string(60, '.'));
+    }
+
+    void
+    testShrink()
+    {
+        flat_streambuf sb;
+        sb.reserve(1000);
+        append(sb, "Hello, world");
+        sb.consume(7);
+        sb.shrink_to_fit();
+        BEAST_EXPECT(sb.capacity() == 5);
+        BEAST_EXPECT(to_string(sb.data()) == "world");
+        sb.consume(5);
+        sb.shrink_to_fit();
+        BEAST_EXPECT(sb.capacity() == 0);
+        append(sb, "!");
+        BEAST_EXPECT(to_string(sb.data()) == "!");
+    }
+
+    void
+    testAllocator()
+    {
+        using alloc_type = counting_allocator<char>;
+        alloc_type a1;
+        alloc_type a2;
+        basic_flat_streambuf<alloc_type> sb1(
+            std::numeric_limits<std::size_t>::max(), a1);
+        append(sb1, "Hello");
+        BEAST_EXPECT(a1.count() == 1);
+        // Allocators differ and do not propagate: the data is copied
+        basic_flat_streambuf<alloc_type> sb2(
+            std::numeric_limits<std::size_t>::max(), a2);
+        sb2 = std::move(sb1);
+        BEAST_EXPECT(a2.count() == 1);
+        BEAST_EXPECT(sb1.capacity() == 0);
+        BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+        // Equal allocators: the storage is taken
+        basic_flat_streambuf<alloc_type> sb3(
+            std::numeric_limits<std::size_t>::max(), a2);
+        sb3 = std::move(sb2);
+        BEAST_EXPECT(a2.count() == 1);
+        BEAST_EXPECT(to_string(sb3.data()) == "Hello");
+        basic_flat_streambuf<alloc_type> sb4(sb3);
+        BEAST_EXPECT(sb4.get_allocator() == a2);
+        BEAST_EXPECT(to_string(sb4.data()) == "Hello");
+    }
+
+    void
+    testReadSizeHelper()
+    {
+        flat_streambuf sb(1000);
+        BEAST_EXPECT(read_size_helper(sb, 0) == 0);
+        BEAST_EXPECT(read_size_helper(sb, 1) == 1);
+        BEAST_EXPECT(read_size_helper(sb, 2000) == 512);
+        sb.reserve(600);
+        BEAST_EXPECT(read_size_helper(sb, 2000) == 600);
+        append(sb, std::string(600, '*'));
+        BEAST_EXPECT(read_size_helper(sb, 2000) == 400);
+        sb.consume(300);
+        BEAST_EXPECT(read_size_helper(sb, 2000) == 512);
+        sb.consume(300);
+        BEAST_EXPECT(read_size_helper(sb, 2000) == 600);
+    }
+
+    void run() override
+    {
+        testMatrix();
+        testCompact();
+        testMaxSize();
+        testShrink();
+        testAllocator();
+        testReadSizeHelper();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_streambuf,core,beast);
+
+} // beast
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/monotonic_arena.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace beast {
+
+class monotonic_arena_test : public beast::unit_test::suite
+{
+public:
+    void
+    testArena()
+    {
+        monotonic_arena arena(256);
+        auto const p = static_cast<char*>(arena.allocate(10));
+        BEAST_EXPECT(reinterpret_cast<std::uintptr_t>(p) % 16 == 0);
+        auto const q = static_cast<char*>(arena.allocate(1));
+        BEAST_EXPECT(q == p + 16);
+        // Freeing the last allocation returns its bytes
+        arena.deallocate(q, 1);
+        BEAST_EXPECT(arena.allocate(5) == q);
+        // Freeing any other allocation does nothing
+        arena.deallocate(p, 10);
+        BEAST_EXPECT(arena.allocate(1) == q + 16);
+        // Large requests get a chunk of their own
+        auto const r = static_cast<char*>(arena.allocate(100000));
+        std::memset(r, 0, 100000);
+        BEAST_EXPECT(arena.allocate(1) == q + 32);
+        for(std::size_t i = 0; i < 1000; ++i)
+            std::memset(arena.allocate(i + 1), 0, i + 1);
+    }
+
+    void
+    testClear()
+    {
+        monotonic_arena arena(256);
+        arena.clear();
+        for(std::size_t i = 0; i < 1000; ++i)
+            std::memset(arena.allocate(i + 1), 0, i + 1);
+        arena.allocate(200000);
+        arena.clear();
+        // The arena reuses its largest chunk
+        auto const p = arena.allocate(100);
+        for(std::size_t i = 0; i < 10; ++i)
+        {
+            arena.clear();
+            BEAST_EXPECT(arena.allocate(100) == p);
+        }
+    }
+
+    void
+    testAllocator()
+    {
+        using alloc_type = arena_allocator<char, monotonic_arena>;
+        using string_type = std::basic_string<
+            char, std::char_traits<char>, alloc_type>;
+        monotonic_arena arena;
+        {
+            alloc_type a(arena);
+            BEAST_EXPECT(&a.arena() == &arena);
+            string_type s(a);
+            for(int i = 0; i < 1000; ++i)
+                s.append("*");
+            BEAST_EXPECT(s.size() == 1000);
+            std::vector<string_type, arena_allocator<
+                string_type, monotonic_arena>> v(a);
+            v.emplace_back(s);
+            BEAST_EXPECT(v.back() == s);
+        }
+        arena.clear();
+    }
+
+    void run() override
+    {
+        testArena();
+        testClear();
+        testAllocator();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(monotonic_arena,core,beast);
+
+} // beast
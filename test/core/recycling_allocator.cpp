@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/recycling_allocator.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <string>
+#include <thread>
+
+namespace beast {
+
+class recycling_allocator_test : public beast::unit_test::suite
+{
+public:
+    void
+    testSizes()
+    {
+        using detail::recycling_cache;
+        BEAST_EXPECT(recycling_cache::index(0) == 0);
+        BEAST_EXPECT(recycling_cache::index(64) == 0);
+        BEAST_EXPECT(recycling_cache::index(65) == 1);
+        BEAST_EXPECT(recycling_cache::index(16384) ==
+            recycling_cache::count - 1);
+    }
+
+    void
+    testAllocator()
+    {
+        recycling_allocator<char> a;
+        // The last freed block of a class is reused
+        auto const p = a.allocate(100);
+        std::memset(p, 0, 100);
+        a.deallocate(p, 100);
+        auto const q = a.allocate(120);
+        BEAST_EXPECT(q == p);
+        // Only one block per class is kept
+        auto const r = a.allocate(100);
+        BEAST_EXPECT(r != q);
+        a.deallocate(q, 120);
+        a.deallocate(r, 100);
+        // Requests beyond the size classes
+        auto const s = a.allocate(100000);
+        std::memset(s, 0, 100000);
+        a.deallocate(s, 100000);
+        // Blocks may be freed on another thread
+        auto const t = a.allocate(1000);
+        std::thread th([&]{ a.deallocate(t, 1000); });
+        th.join();
+        {
+            std::list<std::string, recycling_allocator<std::string>> l;
+            for(int i = 0; i < 100; ++i)
+                l.emplace_back(std::to_string(i));
+            BEAST_EXPECT(l.back() == "99");
+        }
+        BEAST_EXPECT(recycling_allocator<int>{} == recycling_allocator<char>{});
+        BEAST_EXPECT(! (recycling_allocator<int>{} != recycling_allocator<char>{}));
+    }
+
+    void
+    testHandler()
+    {
+        int n = 0;
+        auto h = bind_recycling_allocator(
+            [&](int v) { n = v; });
+        auto const p = boost_asio_handler_alloc_helpers::allocate(200, h);
+        boost_asio_handler_alloc_helpers::deallocate(p, 200, h);
+        // The handler uses the recycling cache
+        recycling_allocator<char> a;
+        auto const q = a.allocate(200);
+        BEAST_EXPECT(q == p);
+        a.deallocate(q, 200);
+        h(42);
+        BEAST_EXPECT(n == 42);
+    }
+
+    struct chain
+    {
+        boost::asio::io_service& ios;
+        boost::asio::io_service::strand& strand;
+        int& n;
+
+        void
+        operator()()
+        {
+            if(++n < 1000)
+                ios.post(bind_recycling_allocator(
+                    strand.wrap(*this)));
+        }
+    };
+
+    void
+    testChain()
+    {
+        boost::asio::io_service ios;
+        boost::asio::io_service::strand strand(ios);
+        int n = 0;
+        ios.post(bind_recycling_allocator(
+            strand.wrap(chain{ios, strand, n})));
+        ios.run();
+        BEAST_EXPECT(n == 1000);
+    }
+
+    void run() override
+    {
+        testSizes();
+        testAllocator();
+        testHandler();
+        testChain();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(recycling_allocator,core,beast);
+
+} // beast
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/slab_allocator.hpp>
+
+#include <beast/core/basic_streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+
+namespace {
+
+// Constructed before and destroyed after the registry of caches
+basic_streambuf<slab_allocator<char>> static_sb(100);
+
+} // (anon)
+
+class slab_allocator_test : public beast::unit_test::suite
+{
+public:
+    void
+    testSizes()
+    {
+        using detail::slab_sizes;
+        for(std::size_t n = 1; n <= slab_sizes::max_size; ++n)
+        {
+            auto const i = slab_sizes::index(n);
+            if(! BEAST_EXPECT(i < slab_sizes::count))
+                return;
+            if(! BEAST_EXPECT(slab_sizes::size(i) >= n))
+                return;
+            if(i > 0 && ! BEAST_EXPECT(slab_sizes::size(i - 1) < n))
+                return;
+        }
+        for(std::size_t i = 0; i < slab_sizes::count; ++i)
+        {
+            BEAST_EXPECT(slab_sizes::size(i) % slab_sizes::align == 0);
+            BEAST_EXPECT(slab_sizes::index(slab_sizes::size(i)) == i);
+        }
+        BEAST_EXPECT(slab_sizes::size(slab_sizes::count - 1) ==
+            slab_sizes::max_size);
+    }
+
+    void
+    testAllocate()
+    {
+        slab_allocator<char> a;
+        std::vector<std::pair<char*, std::size_t>> v;
+        for(std::size_t i = 0; i < 2000; ++i)
+        {
+            auto const n = 1 + (i * 7919) % 20000;
+            auto const p = a.allocate(n);
+            BEAST_EXPECT(reinterpret_cast<std::uintptr_t>(p) % 16 == 0);
+            std::memset(p, static_cast<int>(i & 0xff), n);
+            v.emplace_back(p, n);
+        }
+        // No block overlaps another
+        for(std::size_t i = 0; i < v.size(); ++i)
+            BEAST_EXPECT(std::all_of(v[i].first, v[i].first + v[i].second,
+                [&](char c) { return c == static_cast<char>(i & 0xff); }));
+        for(auto const& e : v)
+            a.deallocate(e.first, e.second);
+        // Freed blocks are reused first
+        auto const p = a.allocate(100);
+        a.deallocate(p, 100);
+        BEAST_EXPECT(a.allocate(100) == p);
+        a.deallocate(p, 100);
+    }
+
+    void
+    testCrossThread()
+    {
+        slab_allocator<char> a;
+        // A block freed on another thread returns to this one
+        auto const p = a.allocate(3000);
+        std::thread t(
+            [&]
+            {
+                a.deallocate(p, 3000);
+                // Freeing does not give the thread a cache
+                BEAST_EXPECT(! detail::slab_cache::current());
+            });
+        t.join();
+        std::vector<char*> v;
+        bool found = false;
+        for(std::size_t i = 0; i < 1000 && ! found; ++i)
+        {
+            v.push_back(a.allocate(3000));
+            found = v.back() == p;
+        }
+        BEAST_EXPECT(found);
+        for(auto q : v)
+            a.deallocate(q, 3000);
+
+        // Threads exchange blocks in both directions
+        std::mutex m;
+        std::vector<char*> shared;
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < 4; ++i)
+            threads.emplace_back(
+                [&, i]
+                {
+                    slab_allocator<char> alloc;
+                    for(std::size_t j = 0; j < 10000; ++j)
+                    {
+                        auto const n = 1 + (j * 31 + i) % 512;
+                        auto const q = alloc.allocate(512);
+                        std::memset(q, 0, n);
+                        std::lock_guard<std::mutex> lock(m);
+                        shared.push_back(q);
+                        if(shared.size() > 100)
+                        {
+                            alloc.deallocate(shared.front(), 512);
+                            shared.erase(shared.begin());
+                        }
+                    }
+                });
+        for(auto& th : threads)
+            th.join();
+        for(auto q : shared)
+            a.deallocate(q, 512);
+        pass();
+    }
+
+    void
+    testStatic()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        // Blocks freed during static destruction
+        std::string const s(1000, '*');
+        static_sb.commit(buffer_copy(
+            static_sb.prepare(s.size()), buffer(s)));
+        BEAST_EXPECT(static_sb.size() == s.size());
+    }
+
+    void
+    testContainers()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        {
+            basic_streambuf<slab_allocator<char>> sb(100);
+            std::string const s(1000, '*');
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            sb.consume(500);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(500));
+        }
+        {
+            std::vector<int, slab_allocator<int>> v;
+            for(int i = 0; i < 10000; ++i)
+                v.push_back(i);
+            BEAST_EXPECT(v[9999] == 9999);
+            std::list<std::string, slab_allocator<std::string>> l;
+            for(int i = 0; i < 100; ++i)
+                l.emplace_back(std::to_string(i));
+            BEAST_EXPECT(l.back() == "99");
+        }
+        BEAST_EXPECT(slab_allocator<int>{} == slab_allocator<char>{});
+        BEAST_EXPECT(! (slab_allocator<int>{} != slab_allocator<char>{}));
+    }
+
+    void run() override
+    {
+        testSizes();
+        testAllocate();
+        testCrossThread();
+        testContainers();
+        testStatic();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(slab_allocator,core,beast);
+
+} // beast
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/slab_arena.hpp>
+
+#include <beast/core/basic_streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace beast {
+
+class slab_arena_test : public beast::unit_test::suite
+{
+public:
+    void
+    testArena()
+    {
+        slab_arena arena(64);
+        auto const p = arena.allocate(100);
+        BEAST_EXPECT(reinterpret_cast<std::uintptr_t>(p) % 16 == 0);
+        arena.deallocate(p, 100);
+        // Freed blocks are reused by requests of the same class
+        BEAST_EXPECT(arena.allocate(110) == p);
+        // Larger requests than the chunk size
+        auto const q = arena.allocate(10000);
+        std::memset(q, 0, 10000);
+        // Requests beyond the size classes
+        auto const r = arena.allocate(100000);
+        std::memset(r, 0, 100000);
+        arena.deallocate(r, 100000);
+        arena.allocate(200000);
+        for(std::size_t i = 0; i < 1000; ++i)
+            std::memset(arena.allocate(i + 1), 0, i + 1);
+        // The destructor releases everything
+        pass();
+    }
+
+    void
+    testAllocator()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        slab_arena a1;
+        slab_arena a2;
+        arena_allocator<char> c1(a1);
+        arena_allocator<int> i1(c1);
+        BEAST_EXPECT(c1 == i1);
+        BEAST_EXPECT(&i1.arena() == &a1);
+        BEAST_EXPECT(arena_allocator<char>(a2) != i1);
+        {
+            basic_streambuf<arena_allocator<char>> sb(100, c1);
+            std::string const s(1000, '*');
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            sb.consume(500);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(500));
+            // The allocator moves with the buffer
+            basic_streambuf<arena_allocator<char>> sb2(
+                100, arena_allocator<char>(a2));
+            sb2 = std::move(sb);
+            BEAST_EXPECT(&sb2.get_allocator().arena() == &a1);
+            BEAST_EXPECT(to_string(sb2.data()) == s.substr(500));
+        }
+        {
+            std::vector<int, arena_allocator<int>> v(i1);
+            for(int i = 0; i < 10000; ++i)
+                v.push_back(i);
+            BEAST_EXPECT(v[9999] == 9999);
+        }
+    }
+
+    void run() override
+    {
+        testArena();
+        testAllocator();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(slab_arena,core,beast);
+
+} // beast
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/static_buffer_list.hpp>
+
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/consuming_buffers.hpp>
+#include <beast/core/prepare_buffers.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <list>
+#include <string>
+
+namespace beast {
+
+class static_buffer_list_test : public beast::unit_test::suite
+{
+public:
+    void
+    testAppend()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        std::string const s = "Hello, world!";
+        std::list<const_buffer> b1{
+            buffer(s.data(), 5), const_buffer{}};
+        std::array<const_buffer, 2> b2{{
+            buffer(s.data() + 5, 2), buffer(s.data() + 7, 6)}};
+        static_buffer_list<4> bl;
+        BEAST_EXPECT(bl.empty());
+        BEAST_EXPECT(bl.capacity() == 4);
+        // Nested concatenations are flattened into the list
+        BEAST_EXPECT(bl.append(buffer_cat(b1, b2)));
+        BEAST_EXPECT(bl.end() - bl.begin() == 3);
+        BEAST_EXPECT(to_string(bl) == s);
+        // A sequence which does not fit leaves the list unchanged
+        BEAST_EXPECT(! bl.append(b2));
+        BEAST_EXPECT(bl.end() - bl.begin() == 3);
+        BEAST_EXPECT(bl.append(consumed_buffers(b2, 2)));
+        BEAST_EXPECT(to_string(bl) == s + s.substr(7));
+        bl.clear();
+        BEAST_EXPECT(bl.empty());
+        BEAST_EXPECT(buffer_size(bl) == 0);
+        try
+        {
+            static_buffer_list<2> bl2(buffer_cat(b1, b2));
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        static_buffer_list<3> bl3(buffer_cat(b1, b2));
+        auto const bl4 = bl3;
+        BEAST_EXPECT(to_string(bl4) == s);
+    }
+
+    void
+    testConsume()
+    {
+        using boost::asio::buffer;
+        std::string const s = "Hello, world!";
+        std::array<boost::asio::const_buffer, 3> b{{
+            buffer(s.data(), 5),
+            buffer(s.data() + 5, 2),
+            buffer(s.data() + 7, 6)}};
+        for(std::size_t i = 0; i <= s.size() + 1; ++i)
+        {
+            static_buffer_list<3> bl(b);
+            bl.consume(i);
+            BEAST_EXPECT(to_string(bl) == s.substr(
+                std::min(i, s.size())));
+            BEAST_EXPECT(bl.empty() == (i >= s.size()));
+            // Room freed at the front is reused
+            BEAST_EXPECT(bl.append(boost::asio::buffer(s.data(), 1)) ==
+                (i >= 5));
+        }
+        static_buffer_list<3> bl(b);
+        for(std::size_t i = 0; i < s.size(); ++i)
+        {
+            BEAST_EXPECT(to_string(bl) == s.substr(i));
+            bl.consume(1);
+        }
+        BEAST_EXPECT(bl.empty());
+    }
+
+    void
+    testPrepare()
+    {
+        using boost::asio::buffer;
+        std::string const s = "Hello, world!";
+        std::array<boost::asio::const_buffer, 3> b{{
+            buffer(s.data(), 5),
+            buffer(s.data() + 5, 2),
+            buffer(s.data() + 7, 6)}};
+        for(std::size_t i = 0; i <= s.size() + 1; ++i)
+        {
+            static_buffer_list<3> bl(b);
+            bl.prepare(i);
+            BEAST_EXPECT(to_string(bl) == s.substr(0, i));
+            BEAST_EXPECT(to_string(bl) ==
+                to_string(prepare_buffers(i, b)));
+            static_buffer_list<3> bl2(b);
+            bl2.consume(3);
+            bl2.prepare(i);
+            BEAST_EXPECT(to_string(bl2) == s.substr(3, i));
+        }
+    }
+
+    void run() override
+    {
+        testAppend();
+        testConsume();
+        testPrepare();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(static_buffer_list,core,beast);
+
+} // beast
@@ -9,15 +9,106 @@
 #include <beast/core/write_dynabuf.hpp>
 
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cstdint>
+#include <limits>
 
 namespace beast {
 
 class write_dynabuf_test : public beast::unit_test::suite
 {
 public:
+    template<class T>
+    static
+    std::string
+    str(T const& t)
+    {
+        streambuf sb;
+        write(sb, t);
+        return to_string(sb.data());
+    }
+
+    // Formatted numbers must match boost::lexical_cast
+    template<class T>
+    void
+    check(T t)
+    {
+        BEAST_EXPECTS(str(t) == boost::lexical_cast<std::string>(t),
+            boost::lexical_cast<std::string>(t));
+    }
+
+    template<class T>
+    void
+    checkLimits()
+    {
+        check(T{0});
+        check(T{1});
+        check((std::numeric_limits<T>::min)());
+        check((std::numeric_limits<T>::max)());
+    }
+
+    void
+    testIntegers()
+    {
+        checkLimits<short>();
+        checkLimits<unsigned short>();
+        checkLimits<int>();
+        checkLimits<unsigned>();
+        checkLimits<long>();
+        checkLimits<unsigned long>();
+        checkLimits<long long>();
+        checkLimits<unsigned long long>();
+        for(std::int64_t i = -1000; i <= 1000; ++i)
+            check(i);
+        for(std::uint64_t i = 1; i != 0 &&
+                i < (std::numeric_limits<std::uint64_t>::max)() / 7;
+                    i = i * 7 + 3)
+        {
+            check(i - 1);
+            check(i);
+            check(static_cast<std::int64_t>(i) * -1);
+        }
+        // Characters and bool are not formatted as numbers
+        BEAST_EXPECT(str('x') == "x");
+        BEAST_EXPECT(str(true) == "1");
+    }
+
+    void
+    testFloats()
+    {
+        check(0.0);
+        check(-0.0);
+        check(0.1);
+        check(1.5);
+        check(-123.456);
+        check(1e300);
+        check(-2.5e-300);
+        check(1.0 / 3);
+        check((std::numeric_limits<double>::max)());
+        check((std::numeric_limits<double>::min)());
+        check(0.1f);
+        check(3.25f);
+        check((std::numeric_limits<float>::max)());
+        check(1.0L / 3);
+    }
+
+    void
+    testMixed()
+    {
+        streambuf sb;
+        write(sb, "Content-Length: ", 1234567, "\r\n", 1.5, '!');
+        BEAST_EXPECT(to_string(sb.data()) ==
+            "Content-Length: 1234567\r\n1.5!");
+    }
+
     void run() override
     {
+        testIntegers();
+        testFloats();
+        testMixed();
+
         streambuf sb;
         std::string s;
         write(sb, boost::asio::const_buffer{"", 0});
@@ -157,6 +157,110 @@ public:
         }
     }
 
+    // Parser which only wants the header fields
+    struct field_checker
+        : public basic_parser_v1<true, field_checker>
+    {
+        std::string field;
+        std::string value;
+
+    private:
+        friend class basic_parser_v1<true, field_checker>;
+
+        void on_field(boost::string_ref const& s, error_code&)
+        {
+            field.append(s.data(), s.size());
+        }
+        void on_value(boost::string_ref const& s, error_code&)
+        {
+            value.append(s.data(), s.size());
+        }
+    };
+
+    // Parser with no callbacks at all
+    template<bool isRequest>
+    struct null_parser
+        : public basic_parser_v1<isRequest, null_parser<isRequest>>
+    {
+    };
+
+    // Check parsers which omit some or all callbacks
+    void
+    testPartialCallbacks()
+    {
+        using boost::asio::buffer;
+        {
+            field_checker p;
+            error_code ec;
+            std::string const s =
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "\r\n";
+            p.write(buffer(s.data(), 10), ec);
+            p.write(buffer(s.data() + 10, s.size() - 10), ec);
+            if(BEAST_EXPECT(! ec))
+            {
+                BEAST_EXPECT(p.complete());
+                BEAST_EXPECT(p.field == "User-Agent");
+                BEAST_EXPECT(p.value == "test");
+            }
+        }
+        {
+            null_parser<false> p;
+            error_code ec;
+            p.write(buf(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 4\r\n"
+                "\r\n"
+                "****"
+                ), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+        }
+        {
+            // Limits apply even when the callbacks are absent
+            null_parser<true> p;
+            p.set_option(headers_max_size{20});
+            error_code ec;
+            p.write(buf(
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "\r\n"
+                ), ec);
+            BEAST_EXPECT(ec == parse_error::headers_too_big);
+        }
+        {
+            null_parser<false> p;
+            p.set_option(body_max_size{2});
+            error_code ec;
+            p.write(buf(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 4\r\n"
+                "\r\n"
+                "****"
+                ), ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+        {
+            // Chunk extensions split across
+            // buffers count against the limit
+            test::fail_counter fc(1000);
+            fail_parser<true> p(fc);
+            p.set_option(headers_max_size{256});
+            error_code ec;
+            p.write(buf(
+                "GET / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1;x="
+                ), ec);
+            BEAST_EXPECT(! ec);
+            std::string const s(300, 'x');
+            p.write(boost::asio::buffer(s), ec);
+            BEAST_EXPECT(ec == parse_error::headers_too_big);
+        }
+    }
+
     //--------------------------------------------------------------------------
 
     template<class F>
@@ -815,6 +919,32 @@ public:
         }
     };
 
+    class ext_f
+    {
+        suite& s_;
+        std::string const& body_;
+        std::string const& ext_;
+
+    public:
+        ext_f(ext_f&&) = default;
+
+        ext_f(suite& s, std::string const& body,
+                std::string const& ext)
+            : s_(s)
+            , body_(body)
+            , ext_(ext)
+        {
+        }
+
+        template<class Parser>
+        void
+        operator()(Parser const& p) const
+        {
+            s_.BEAST_EXPECT(p.body == body_);
+            s_.BEAST_EXPECT(p.ext == ext_);
+        }
+    };
+
     template<std::size_t N>
     static
     boost::asio::const_buffers_1
@@ -1007,7 +1137,7 @@ public:
             BEAST_EXPECT(p.complete());
         }
 
-        bad<false>(3,
+        bad<false>(4,
             "HTTP/1.1 200 OK\r\n"
             "Content-Length: 1\r\n"
             "\r\n*", parse_error::bad_on_headers_rv);
@@ -1092,6 +1222,67 @@ public:
         bad<true>(ce("1;x,\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_name);
     }
 
+    void testChunkExtensions()
+    {
+        auto const ext =
+            [&](std::string const& b, std::string const& e)
+            {
+                return ext_f{*this, b, e};
+            };
+        auto const ce =
+            [](std::string const& s)
+            {
+                return
+                    "GET / HTTP/1.1\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n" + s;
+            };
+
+        good<true>(ce("1\r\n*\r\n" "0\r\n\r\n"),          ext("*", ""));
+        good<true>(ce("1;x\r\n*\r\n" "0\r\n\r\n"),        ext("*", ";x"));
+        good<true>(ce("1;x\r\n*\r\n" "0;y=1\r\n\r\n"),    ext("*", ";x;y=1"));
+        good<true>(ce("1;i;j=2;k=\"3\"\r\n*\r\n" "0\r\n\r\n"), ext("*", ";i;j=2;k=\"3\""));
+        good<true>(ce("1 ;a = b \r\n*\r\n" "0\r\n\r\n"),  ext("*", " ;a = b "));
+        good<true>(ce("1;a=\"x\\\"; y\"\r\n*\r\n" "0\r\n\r\n"), ext("*", ";a=\"x\\\"; y\""));
+        good<true>(ce("2;a\r\n**\r\n" "1;b\r\n*\r\n" "0\r\n\r\n"), ext("***", ";a;b"));
+
+        bad<true>(ce("1;a b\r\n*\r\n" "0\r\n\r\n"),       parse_error::invalid_ext_name);
+        bad<true>(ce("1;=b\r\n*\r\n" "0\r\n\r\n"),        parse_error::invalid_ext_name);
+        bad<true>(ce("1;a=,\r\n*\r\n" "0\r\n\r\n"),       parse_error::invalid_ext_val);
+        bad<true>(ce("1;a=b,\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_val);
+        bad<true>(ce("1;a=\"\x01\"\r\n*\r\n" "0\r\n\r\n"), parse_error::invalid_ext_val);
+    }
+
+    void testTrailers()
+    {
+        auto const body =
+            [&](std::string const& s)
+            {
+                return body_f{*this, s};
+            };
+        auto const ce =
+            [](std::string const& s)
+            {
+                return
+                    "GET / HTTP/1.1\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n" + s;
+            };
+
+        good<true>(ce("1\r\n*\r\n" "0\r\n" "Expires: never\r\n" "\r\n"), body("*"));
+        good<true>(ce("1\r\n*\r\n" "0\r\n" "A: 1\r\n" "B: 2\r\n" "\r\n"), body("*"));
+
+        // Trailer fields do not change the message semantics
+        good<true>(ce("1\r\n*\r\n" "0\r\n" "Content-Length: x\r\n" "\r\n"), body("*"));
+        good<true>(ce("1\r\n*\r\n" "0\r\n" "Connection: close\r\n" "\r\n"),
+            [&](fail_parser<true> const& p)
+            {
+                BEAST_EXPECT(p.keep_alive());
+            });
+
+        bad<true>(ce("1\r\n*\r\n" "0\r\n" "A 1\r\n" "\r\n"), parse_error::bad_field);
+    }
+
     void testLimits()
     {
         std::size_t n;
@@ -1153,6 +1344,7 @@ public:
     void run() override
     {
         testCallbacks();
+        testPartialCallbacks();
         testRequestLine();
         testStatusLine();
         testHeaders();
@@ -1162,6 +1354,8 @@ public:
         testUpgradeHeader();
         testBody();
         testChunkedBody();
+        testChunkExtensions();
+        testTrailers();
         testLimits();
     }
 };
@@ -24,6 +24,7 @@ class fail_parser
 
 public:
     std::string body;
+    std::string ext;
 
     template<class... Args>
     explicit
@@ -100,6 +101,14 @@ public:
         body.append(s.data(), s.size());
     }
 
+    void on_chunk_header(std::uint64_t,
+        boost::string_ref const& s, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        ext.append(s.data(), s.size());
+    }
+
     void on_complete(error_code& ec)
     {
         fc_.fail(ec);
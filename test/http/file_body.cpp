@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/file_body.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/message_v1.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+class file_body_test : public beast::unit_test::suite
+{
+public:
+    // A temporary file, removed on destruction
+    class temp_file
+    {
+        std::string path_;
+
+    public:
+        explicit
+        temp_file(std::string const& s)
+            : path_((boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path()).string())
+        {
+            std::ofstream os(path_, std::ios::binary);
+            os.write(s.data(), s.size());
+        }
+
+        ~temp_file()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(path_, ec);
+        }
+
+        std::string const&
+        path() const
+        {
+            return path_;
+        }
+    };
+
+    static
+    std::string
+    make_data(std::size_t size)
+    {
+        std::string s;
+        s.reserve(size);
+        for(std::size_t i = 0; i < size; ++i)
+            s.push_back(static_cast<char>('a' + i % 26));
+        return s;
+    }
+
+    static
+    std::string
+    head(std::size_t size)
+    {
+        return
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: " + std::to_string(size) + "\r\n"
+            "\r\n";
+    }
+
+    template<class... Args>
+    static
+    response_v1<file_body>
+    make_response(Args&&... args)
+    {
+        response_v1<file_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.body = file_body::value_type(std::forward<Args>(args)...);
+        prepare(m);
+        return m;
+    }
+
+    void
+    testWrite()
+    {
+        // Larger than the buffer, and not a multiple of it
+        auto const s = make_data(3 * file_body::buffer_size + 100);
+        temp_file f{s};
+        {
+            auto const m = make_response(f.path());
+            BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+                head(s.size()) + s);
+        }
+        {
+            auto const m = make_response(f.path(), 1000, 70000);
+            BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+                head(70000) + s.substr(1000, 70000));
+        }
+        {
+            // Range extends past the end of the file
+            auto const m = make_response(f.path(), s.size() - 5, 100);
+            BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+                head(5) + s.substr(s.size() - 5));
+        }
+        {
+            auto const m = make_response(f.path(), s.size(), 100);
+            BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+                head(0));
+        }
+    }
+
+    void
+    testErrors()
+    {
+        temp_file f{"*****"};
+        try
+        {
+            make_response(f.path(), 6, 1);
+            fail();
+        }
+        catch(system_error const&)
+        {
+            pass();
+        }
+        try
+        {
+            make_response(f.path() + ".missing");
+            fail();
+        }
+        catch(system_error const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    testSocket()
+    {
+        using boost::asio::ip::tcp;
+        auto const s = make_data(1024 * 1024 + 1);
+        temp_file f{s};
+        auto const m = make_response(f.path(), 3, s.size());
+        auto const expected = head(s.size() - 3) + s.substr(3);
+
+        boost::asio::io_service ios;
+        tcp::acceptor acceptor{ios, tcp::endpoint{
+            boost::asio::ip::address_v4::loopback(), 0}};
+        tcp::socket client{ios};
+        tcp::socket server{ios};
+        client.connect(acceptor.local_endpoint());
+        acceptor.accept(server);
+        std::string got;
+        got.resize(expected.size());
+        std::thread t{
+            [&]
+            {
+                error_code ec;
+                boost::asio::read(client,
+                    boost::asio::buffer(&got[0], got.size()), ec);
+            }};
+        error_code ec;
+        write(server, m, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        t.join();
+        BEAST_EXPECT(got == expected);
+
+        async_write(server, m,
+            [&](error_code const& ec)
+            {
+                BEAST_EXPECTS(! ec, ec.message());
+            });
+        t = std::thread{[&]{ ios.run(); }};
+        got.clear();
+        got.resize(expected.size());
+        boost::asio::read(client,
+            boost::asio::buffer(&got[0], got.size()), ec);
+        t.join();
+        BEAST_EXPECT(got == expected);
+
+        // Synchronous operations still block afterwards
+        BEAST_EXPECT(! server.non_blocking());
+        t = std::thread{
+            [&]
+            {
+                error_code ec;
+                boost::asio::read(client,
+                    boost::asio::buffer(&got[0], got.size()), ec);
+            }};
+        write(server, m, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        t.join();
+        BEAST_EXPECT(got == expected);
+    }
+
+    void run() override
+    {
+        testWrite();
+        testErrors();
+        testSocket();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(file_body,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_parser_v1.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/read.hpp>
+#include <beast/http/streambuf_body.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <array>
+
+namespace beast {
+namespace http {
+
+class header_parser_v1_test : public beast::unit_test::suite
+{
+public:
+    void testWrite()
+    {
+        using boost::asio::buffer;
+        {
+            error_code ec;
+            header_parser_v1<true, headers> hp;
+            std::string const s =
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****";
+            auto const used = hp.write(buffer(s), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(hp.paused());
+            BEAST_EXPECT(hp.complete());
+            BEAST_EXPECT(used == s.size() - 5);
+            BEAST_EXPECT(hp.get().method == "GET");
+            BEAST_EXPECT(hp.get().url == "/");
+            BEAST_EXPECT(hp.get().version == 11);
+            BEAST_EXPECT(hp.get().headers["User-Agent"] == "test");
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            BEAST_EXPECT(! p.complete());
+            p.write(buffer(s.data() + used, 2), ec);
+            p.write(buffer(s.data() + used + 2, 3), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            auto m = p.release();
+            BEAST_EXPECT(m.method == "GET");
+            BEAST_EXPECT(m.headers["User-Agent"] == "test");
+            BEAST_EXPECT(m.body == "*****");
+        }
+        {
+            error_code ec;
+            header_parser_v1<false, headers> hp;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1\r\n"
+                "*\r\n"
+                "0\r\n\r\n";
+            auto const used = hp.write(buffer(s), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(hp.complete());
+            BEAST_EXPECT(hp.get().status == 200);
+            BEAST_EXPECT(hp.get().reason == "OK");
+            parser_v1<false, string_body, headers> p{std::move(hp)};
+            p.write(buffer(s.data() + used, s.size() - used), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.get().status == 200);
+            BEAST_EXPECT(p.get().body == "*");
+        }
+        {
+            // No body
+            error_code ec;
+            header_parser_v1<true, headers> hp;
+            std::string const s =
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "\r\n";
+            hp.write(buffer(s), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(! hp.paused());
+            BEAST_EXPECT(hp.complete());
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            BEAST_EXPECT(p.complete());
+        }
+    }
+
+    void testSplit()
+    {
+        using boost::asio::buffer;
+        using boost::asio::const_buffer;
+        {
+            // Headers and body split across two buffers
+            error_code ec;
+            header_parser_v1<true, headers> hp;
+            std::string const s1 =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "ab";
+            std::string const s2 = "cde";
+            std::array<const_buffer, 2> const bs{{
+                buffer(s1), buffer(s2)}};
+            auto const used = hp.write(bs, ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(hp.paused());
+            BEAST_EXPECT(hp.complete());
+            BEAST_EXPECT(used == s1.size() - 2);
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            p.write(buffer(s1.data() + used, s1.size() - used), ec);
+            p.write(buffer(s2), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.get().body == "abcde");
+        }
+        {
+            // Headers spanning several streambuf elements
+            boost::asio::io_service ios;
+            test::string_stream ss(ios,
+                "POST /upload HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****");
+            streambuf sb(16);
+            header_parser_v1<true, headers> hp;
+            parse(ss, sb, hp);
+            BEAST_EXPECT(hp.get().url == "/upload");
+            BEAST_EXPECT(hp.get().headers["User-Agent"] == "test");
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            parse(ss, sb, p);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.get().body == "*****");
+        }
+    }
+
+    void testParse()
+    {
+        boost::asio::io_service ios;
+        std::string const s =
+            "POST /upload HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "***"
+            "GET / HTTP/1.1\r\n"
+            "\r\n";
+        test::string_stream ss(ios, s);
+        streambuf sb;
+        {
+            header_parser_v1<true, headers> hp;
+            parse(ss, sb, hp);
+            BEAST_EXPECT(hp.get().url == "/upload");
+            parser_v1<true, streambuf_body, headers> p{std::move(hp)};
+            parse(ss, sb, p);
+            BEAST_EXPECT(to_string(p.get().body.data()) == "***");
+        }
+        {
+            header_parser_v1<true, headers> hp;
+            parse(ss, sb, hp);
+            BEAST_EXPECT(hp.get().url == "/");
+            parser_v1<true, string_body, headers> p{std::move(hp)};
+            parse(ss, sb, p);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.get().body.empty());
+        }
+    }
+
+    void run() override
+    {
+        testWrite();
+        testSplit();
+        testParse();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_parser_v1,http,beast);
+
+} // http
+} // beast
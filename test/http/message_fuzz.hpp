@@ -10,6 +10,7 @@
 
 #include <beast/core/write_dynabuf.hpp>
 #include <beast/http/detail/basic_parser_v1.hpp>
+#include <beast/http/detail/rfc7230.hpp>
 #include <cstdint>
 #include <random>
 #include <string>
@@ -552,6 +553,38 @@ public:
         body(db);
         write(db, "\r\n");
     }
+
+    // A response with a chunked body of the given size,
+    // with random chunk extensions and trailers.
+    template<class DynamicBuffer>
+    void
+    chunked_response(DynamicBuffer& db, std::size_t size)
+    {
+        write(db, "HTTP/1.1 200 OK\r\n");
+        headers(db);
+        write(db, "Transfer-Encoding: chunked\r\n\r\n");
+        while(size > 0)
+        {
+            auto n = std::min<std::size_t>(1 + rand(16384), size);
+            size -= n;
+            write(db, to_hex(n));
+            while(! rand(4))
+                write(db, ";", token(), "=", token());
+            write(db, "\r\n");
+            for(auto const& b : db.prepare(n))
+            {
+                auto p = boost::asio::buffer_cast<char*>(b);
+                auto m = boost::asio::buffer_size(b);
+                while(m--)
+                    *p++ = static_cast<char>(32 + rand(26+26+10+6));
+            }
+            db.commit(n);
+            write(db, "\r\n");
+        }
+        write(db, "0\r\n");
+        headers(db);
+        write(db, "\r\n");
+    }
 };
 
 using message_fuzz = message_fuzz_t<>;
@@ -19,6 +19,47 @@ namespace http {
 class message_v1_test : public beast::unit_test::suite
 {
 public:
+    // Counts the writers constructed
+    template<bool hasSize>
+    struct counted_body
+    {
+        using value_type = std::string;
+
+        static std::size_t writers;
+
+        template<bool b = hasSize>
+        static
+        typename std::enable_if<b, std::uint64_t>::type
+        size(value_type const& body, error_code&)
+        {
+            return body.size();
+        }
+
+        struct writer
+        {
+            std::size_t size_;
+
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest, counted_body, Headers> const& m)
+                : size_(m.body.size())
+            {
+                ++writers;
+            }
+
+            void
+            init(error_code&)
+            {
+            }
+
+            std::uint64_t
+            content_length() const
+            {
+                return size_;
+            }
+        };
+    };
+
     void testFreeFunctions()
     {
         {
@@ -80,6 +121,24 @@ public:
         BEAST_EXPECT(! is_keep_alive(m));
     }
 
+    static_assert(detail::has_size<string_body>::value, "");
+    static_assert(detail::has_size<empty_body>::value, "");
+    static_assert(! detail::has_size<counted_body<false>>::value, "");
+
+    template<bool hasSize>
+    void
+    testContentLength()
+    {
+        using body_type = counted_body<hasSize>;
+        body_type::writers = 0;
+        response_v1<body_type> m;
+        m.version = 11;
+        m.body = "*****";
+        prepare(m);
+        BEAST_EXPECT(m.headers["Content-Length"] == "5");
+        BEAST_EXPECT(body_type::writers == (hasSize ? 0 : 1));
+    }
+
     void testSwap()
     {
         message_v1<false, string_body, headers> m1;
@@ -110,9 +169,14 @@ public:
         testFreeFunctions();
         testPrepare();
         testSwap();
+        testContentLength<false>();
+        testContentLength<true>();
     }
 };
 
+template<bool hasSize>
+std::size_t message_v1_test::counted_body<hasSize>::writers = 0;
+
 BEAST_DEFINE_TESTSUITE(message_v1,http,beast);
 
 } // http
@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/mmap_body.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/message_v1.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class mmap_body_test : public beast::unit_test::suite
+{
+public:
+    // A temporary file, removed on destruction
+    class temp_file
+    {
+        std::string path_;
+
+    public:
+        explicit
+        temp_file(std::string const& s)
+            : path_((boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path()).string())
+        {
+            write(s);
+        }
+
+        ~temp_file()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(path_, ec);
+        }
+
+        std::string const&
+        path() const
+        {
+            return path_;
+        }
+
+        void
+        write(std::string const& s)
+        {
+            std::ofstream os(path_, std::ios::binary);
+            os.write(s.data(), s.size());
+        }
+    };
+
+    static
+    std::string
+    head(std::size_t size)
+    {
+        return
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: " + std::to_string(size) + "\r\n"
+            "\r\n";
+    }
+
+    static
+    response_v1<mmap_body>
+    make_response(mmap_body::value_type body)
+    {
+        response_v1<mmap_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.body = std::move(body);
+        prepare(m);
+        return m;
+    }
+
+    void
+    testWrite()
+    {
+        std::string const s(100000, '*');
+        temp_file f{s};
+        error_code ec;
+        auto const body = mmap_body::mapping::open(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(body && body->size() == s.size());
+        auto const m = make_response(body);
+        BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+            head(s.size()) + s);
+        // A mapping may be sent any number of times
+        BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+            head(s.size()) + s);
+    }
+
+    void
+    testEmpty()
+    {
+        temp_file f{""};
+        error_code ec;
+        auto const body = mmap_body::mapping::open(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(body && body->size() == 0);
+        auto const m = make_response(body);
+        BEAST_EXPECT(boost::lexical_cast<std::string>(m) == head(0));
+    }
+
+    void
+    testCache()
+    {
+        temp_file f{"*****"};
+        mmap_body::cache c;
+        error_code ec;
+        auto const m1 = c.get(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        auto const m2 = c.get(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(m1 && m1 == m2);
+        BEAST_EXPECT(c.size() == 1);
+
+        // Changing the file replaces the mapping
+        f.write("**********");
+        auto const m3 = c.get(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(m3 && m3 != m1);
+        BEAST_EXPECT(m3->size() == 10);
+        BEAST_EXPECT(m1->size() == 5);
+        BEAST_EXPECT(c.size() == 1);
+
+        // Replacing the file with one of the same size and
+        // modification second replaces the mapping
+        {
+            temp_file f2{"##########"};
+            boost::filesystem::last_write_time(f2.path(),
+                boost::filesystem::last_write_time(f.path()));
+            boost::filesystem::rename(f2.path(), f.path());
+        }
+        auto const m5 = c.get(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(m5 && m5 != m3);
+        BEAST_EXPECT(std::string(static_cast<char const*>(
+            m5->data()), 10) == "##########");
+        BEAST_EXPECT(m5->size() == m3->size());
+        BEAST_EXPECT(m5->mtime() == m3->mtime());
+#ifndef _WIN32
+        // The inode tells the two files apart
+        BEAST_EXPECT(m5->inode() != m3->inode());
+#endif
+        // The old mapping still refers to the old file
+        BEAST_EXPECT(std::string(static_cast<char const*>(
+            m3->data()), 10) == "**********");
+        BEAST_EXPECT(c.size() == 1);
+
+        c.erase(f.path());
+        BEAST_EXPECT(c.size() == 0);
+        auto const m4 = c.get(f.path(), ec);
+        BEAST_EXPECT(m4 && m4 != m3);
+        c.clear();
+        BEAST_EXPECT(c.size() == 0);
+        // Removed mappings remain usable
+        BEAST_EXPECT(boost::lexical_cast<std::string>(
+            make_response(m4)) == head(10) + "##########");
+    }
+
+    void
+    testErrors()
+    {
+        error_code ec;
+        auto const m = mmap_body::cache::instance().get(
+            "/this/file/does/not/exist", ec);
+        BEAST_EXPECT(ec);
+        BEAST_EXPECT(! m);
+        try
+        {
+            boost::lexical_cast<std::string>(make_response(nullptr));
+            fail();
+        }
+        catch(std::exception const&)
+        {
+            pass();
+        }
+    }
+
+    void run() override
+    {
+        testWrite();
+        testEmpty();
+        testCache();
+        testErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(mmap_body,http,beast);
+
+} // http
+} // beast
@@ -102,6 +102,60 @@ public:
     {
     };
 
+    // Only wants the header fields, like a proxy
+    template<bool isRequest>
+    struct fields_parser : basic_parser_v1<isRequest, fields_parser<isRequest>>
+    {
+        std::size_t bytes = 0;
+
+        void on_field(boost::string_ref const& s, error_code&)
+        {
+            bytes += s.size();
+        }
+
+        void on_value(boost::string_ref const& s, error_code&)
+        {
+            bytes += s.size();
+        }
+    };
+
+    // Wants the body and the chunk extensions
+    template<bool isRequest>
+    struct chunk_parser : basic_parser_v1<isRequest, chunk_parser<isRequest>>
+    {
+        std::size_t bytes = 0;
+        std::size_t pieces = 0;
+
+        void on_chunk_header(std::uint64_t,
+            boost::string_ref const& ext, error_code&)
+        {
+            bytes += ext.size();
+        }
+
+        void on_body(boost::string_ref const& s, error_code&)
+        {
+            bytes += s.size();
+            ++pieces;
+        }
+    };
+
+    // Only wants the method and URI, like a router
+    template<bool isRequest>
+    struct route_parser : basic_parser_v1<isRequest, route_parser<isRequest>>
+    {
+        std::size_t bytes = 0;
+
+        void on_method(boost::string_ref const& s, error_code&)
+        {
+            bytes += s.size();
+        }
+
+        void on_uri(boost::string_ref const& s, error_code&)
+        {
+            bytes += s.size();
+        }
+    };
+
     void
     testSpeed()
     {
@@ -138,6 +192,79 @@ public:
                     false, streambuf_body, headers>>(
                         Repeat, cres_);
             });
+        timedTest(Trials, "http::basic_parser_v1 (fields only)",
+            [&]
+            {
+                testParser<fields_parser<true>>(
+                    Repeat, creq_);
+                testParser<fields_parser<false>>(
+                    Repeat, cres_);
+            });
+        timedTest(Trials, "http::basic_parser_v1 (method and uri only)",
+            [&]
+            {
+                testParser<route_parser<true>>(
+                    Repeat, creq_);
+            });
+        timedTest(Trials, "http::basic_parser_v1 (no callbacks)",
+            [&]
+            {
+                testParser<null_parser<true>>(
+                    Repeat, creq_);
+                testParser<null_parser<false>>(
+                    Repeat, cres_);
+            });
+        pass();
+    }
+
+    void
+    testChunkedSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 20;
+        static std::size_t constexpr Count = 16;
+        static std::size_t constexpr Size = 1024 * 1024;
+
+        corpus v;
+        v.resize(Count);
+        std::size_t size = 0;
+        message_fuzz mg;
+        for(auto& sb : v)
+        {
+            mg.chunked_response(sb, Size);
+            size += sb.size();
+        }
+
+        testcase << "Chunked parser speed test, " <<
+            ((Repeat * size + 512) / 1024) << "KB in " <<
+                (Repeat * v.size()) << " messages";
+
+        timedTest(Trials, "nodejs_parser",
+            [&]
+            {
+                testParser<nodejs_parser<
+                    false, streambuf_body, headers>>(
+                        Repeat, v);
+            });
+        timedTest(Trials, "http::basic_parser_v1",
+            [&]
+            {
+                testParser<parser_v1<
+                    false, streambuf_body, headers>>(
+                        Repeat, v);
+            });
+        timedTest(Trials, "http::basic_parser_v1 (body and extensions)",
+            [&]
+            {
+                testParser<chunk_parser<false>>(
+                    Repeat, v);
+            });
+        timedTest(Trials, "http::basic_parser_v1 (no callbacks)",
+            [&]
+            {
+                testParser<null_parser<false>>(
+                    Repeat, v);
+            });
         pass();
     }
 
@@ -145,6 +272,7 @@ public:
     {
         pass();
         testSpeed();
+        testChunkedSpeed();
     }
 };
 
@@ -74,6 +74,29 @@ public:
             BEAST_EXPECT(! ec);
             BEAST_EXPECT(p.complete());
         }
+        // trailers
+        {
+            error_code ec;
+            parser_v1<true, string_body, headers> p;
+            std::string const s =
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "Trailer: Expires, Digest\r\n"
+                "\r\n"
+                "3;x=y\r\n"
+                "abc\r\n"
+                "0\r\n"
+                "Expires: never\r\n"
+                "Digest: 1234\r\n"
+                "\r\n";
+            p.write(buffer(s), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            auto m = p.release();
+            BEAST_EXPECT(m.body == "abc");
+            BEAST_EXPECT(m.headers["Expires"] == "never");
+            BEAST_EXPECT(m.headers["Digest"] == "1234");
+        }
     }
 };
 
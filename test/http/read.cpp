@@ -12,6 +12,9 @@
 
 #include <beast/http/headers.hpp>
 #include <beast/http/streambuf_body.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/monotonic_arena.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -260,6 +263,243 @@ public:
         }
     }
 
+    void testPipelined(yield_context do_yield)
+    {
+        std::string const s =
+            "GET /1 HTTP/1.1\r\n"
+            "Content-Length: 1\r\n"
+            "\r\n"
+            "*"
+            "GET /2 HTTP/1.1\r\n"
+            "\r\n"
+            "GET /3 HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "1\r\n"
+            "*\r\n"
+            "0\r\n\r\n"
+            "GET /4 HTTP/1.1\r\n"
+            "Content-";
+        {
+            // Spread the messages across several elements
+            using boost::asio::buffer;
+            using boost::asio::buffer_copy;
+            streambuf sb(16);
+            for(std::size_t i = 0; i < s.size(); i += 16)
+                sb.commit(buffer_copy(sb.prepare(16),
+                    buffer(s.data() + i, s.size() - i)));
+            test::string_stream ss(ios_, "");
+            std::vector<request_v1<streambuf_body>> v;
+            read_pipelined(ss, sb, v);
+            if(BEAST_EXPECT(v.size() == 3))
+            {
+                BEAST_EXPECT(v[0].url == "/1");
+                BEAST_EXPECT(v[1].url == "/2");
+                BEAST_EXPECT(v[2].url == "/3");
+                BEAST_EXPECT(to_string(v[2].body.data()) == "*");
+            }
+            BEAST_EXPECT(to_string(sb.data()) ==
+                "GET /4 HTTP/1.1\r\nContent-");
+        }
+        {
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            std::vector<request_v1<streambuf_body>> v;
+            error_code ec;
+            async_read_pipelined(ss, sb, v, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 3);
+            BEAST_EXPECT(to_string(sb.data()) ==
+                "GET /4 HTTP/1.1\r\nContent-");
+        }
+        {
+            // No messages after Connection: close
+            streambuf sb;
+            test::string_stream ss(ios_,
+                "GET /1 HTTP/1.1\r\n"
+                "Connection: close\r\n"
+                "\r\n"
+                "GET /2 HTTP/1.1\r\n"
+                "\r\n");
+            std::vector<request_v1<streambuf_body>> v;
+            error_code ec;
+            read_pipelined(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 1);
+        }
+        {
+            // Trailing message with a partial body is left intact
+            std::string const tail =
+                "PUT /2 HTTP/1.1\r\n"
+                "Content-Length: 10\r\n"
+                "\r\n"
+                "*****";
+            streambuf sb;
+            test::string_stream ss(ios_,
+                "GET /1 HTTP/1.1\r\n"
+                "\r\n" + tail);
+            std::vector<request_v1<streambuf_body>> v;
+            error_code ec;
+            read_pipelined(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 1);
+            BEAST_EXPECT(to_string(sb.data()) == tail);
+            sb.commit(boost::asio::buffer_copy(sb.prepare(5),
+                boost::asio::buffer("*****", 5)));
+            read_pipelined(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            if(BEAST_EXPECT(v.size() == 2))
+                BEAST_EXPECT(to_string(v[1].body.data()) ==
+                    "**********");
+            BEAST_EXPECT(sb.size() == 0);
+        }
+        {
+            // Trailing chunked message with a partial body
+            std::string const tail =
+                "PUT /2 HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\n"
+                "**";
+            streambuf sb;
+            test::string_stream ss(ios_,
+                "GET /1 HTTP/1.1\r\n"
+                "\r\n" + tail);
+            std::vector<request_v1<streambuf_body>> v;
+            error_code ec;
+            read_pipelined(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 1);
+            BEAST_EXPECT(to_string(sb.data()) == tail);
+        }
+    }
+
+    void testDirectBody(yield_context do_yield)
+    {
+        std::string const body(200000, '*');
+        std::string const s =
+            "PUT / HTTP/1.1\r\n"
+            "Content-Length: 200000\r\n"
+            "\r\n" + body +
+            "GET /2 HTTP/1.1\r\n"
+            "\r\n";
+        {
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            request_v1<string_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == body);
+            read(ss, sb, m);
+            BEAST_EXPECT(m.url == "/2");
+            BEAST_EXPECT(m.body.empty());
+        }
+        {
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            request_v1<streambuf_body> m;
+            error_code ec;
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(to_string(m.body.data()) == body);
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.url == "/2");
+        }
+        {
+            // Body limit is enforced
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            parser_v1<true, string_body, headers> p;
+            p.set_option(body_max_size{100000});
+            error_code ec;
+            parse(ss, sb, p, ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+        {
+            // Short body
+            streambuf sb;
+            test::string_stream ss(ios_, s.substr(0, 100000));
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            async_parse(ss, sb, p, do_yield[ec]);
+            BEAST_EXPECT(ec == parse_error::short_read);
+        }
+        {
+            // Partial reads into a string body
+            using boost::asio::buffer;
+            using boost::asio::buffer_copy;
+            std::string const h =
+                "PUT / HTTP/1.1\r\n"
+                "Content-Length: 10\r\n"
+                "\r\n";
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            p.write(buffer(h), ec);
+            BEAST_EXPECT(p.body_remain() == 10);
+            auto n = buffer_copy(p.prepare_body(10),
+                buffer("0123", 4));
+            p.commit_body(n, ec);
+            p.commit_body(buffer_copy(p.prepare_body(0),
+                buffer("", 0)), ec);
+            BEAST_EXPECT(p.get().body == "0123");
+            n = buffer_copy(p.prepare_body(6),
+                buffer("456789", 6));
+            p.commit_body(n, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.get().body == "0123456789");
+        }
+    }
+
+    void testArena(yield_context do_yield)
+    {
+        using alloc_type =
+            arena_allocator<char, monotonic_arena>;
+        using request_type = request_v1<
+            basic_string_body<alloc_type>,
+                basic_headers<alloc_type>>;
+        std::string const s =
+            "POST /1 HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: test\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****"
+            "POST /2 HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "***";
+        monotonic_arena arena;
+        streambuf sb;
+        test::string_stream ss(ios_, s);
+        {
+            // The message keeps the allocators it was built with
+            request_type m(std::piecewise_construct,
+                std::make_tuple(alloc_type(arena)),
+                std::make_tuple(alloc_type(arena)));
+            read(ss, sb, m);
+            BEAST_EXPECT(m.url == "/1");
+            BEAST_EXPECT(m.headers["User-Agent"] == "test");
+            BEAST_EXPECT(m.body == "*****");
+            BEAST_EXPECT(&m.headers.get_allocator().arena() == &arena);
+            BEAST_EXPECT(&m.body.get_allocator().arena() == &arena);
+        }
+        arena.clear();
+        {
+            request_type m(std::piecewise_construct,
+                std::make_tuple(alloc_type(arena)),
+                std::make_tuple(alloc_type(arena)));
+            error_code ec;
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.url == "/2");
+            BEAST_EXPECT(m.headers["Content-Length"] == "3");
+            BEAST_EXPECT(m.body == "***");
+            BEAST_EXPECT(&m.body.get_allocator().arena() == &arena);
+        }
+        arena.clear();
+    }
+
     void run() override
     {
         testThrow();
@@ -272,6 +512,15 @@ public:
 
         yield_to(std::bind(&read_test::testEof,
             this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testPipelined,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testDirectBody,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testArena,
+            this, std::placeholders::_1));
     }
 };
 
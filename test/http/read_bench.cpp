@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_fuzz.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/monotonic_arena.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#ifndef _WIN32
+#include <beast/core/circular_streambuf.hpp>
+#endif
+
+namespace beast {
+namespace http {
+
+class read_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 2000;
+
+    std::string corpus_;
+
+    read_bench_test()
+    {
+        streambuf sb;
+        message_fuzz mg;
+        for(std::size_t i = 0; i < N; ++i)
+            mg.request(sb);
+        corpus_ = to_string(sb.data());
+    }
+
+    // Returns the corpus in pieces of at most a given
+    // size, like the reads from a socket.
+    class piece_stream
+    {
+        std::string const& s_;
+        std::size_t piece_;
+        std::size_t pos_ = 0;
+
+    public:
+        piece_stream(std::string const& s, std::size_t piece)
+            : s_(s)
+            , piece_(piece)
+        {
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers)
+        {
+            error_code ec;
+            auto const n = read_some(buffers, ec);
+            if(ec)
+                throw system_error{ec};
+            return n;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            using boost::asio::buffer;
+            using boost::asio::buffer_copy;
+            if(pos_ == s_.size())
+            {
+                ec = boost::asio::error::eof;
+                return 0;
+            }
+            auto const n = buffer_copy(buffers, buffer(
+                s_.data() + pos_, std::min(piece_, s_.size() - pos_)));
+            pos_ += n;
+            return n;
+        }
+    };
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    template<class DynamicBuffer>
+    void
+    testRead(std::size_t repeat, std::size_t piece, DynamicBuffer& db)
+    {
+        while(repeat--)
+        {
+            piece_stream ps(corpus_, piece);
+            for(std::size_t i = 0; i < N; ++i)
+            {
+                request_v1<string_body> m;
+                error_code ec;
+                read(ps, db, m, ec);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    return;
+            }
+            BEAST_EXPECT(db.size() == 0);
+        }
+    }
+
+    // Each message is allocated from an arena
+    // which is cleared when the message is gone.
+    template<class DynamicBuffer>
+    void
+    testReadArena(std::size_t repeat,
+        std::size_t piece, DynamicBuffer& db)
+    {
+        using alloc_type =
+            arena_allocator<char, monotonic_arena>;
+        monotonic_arena arena;
+        while(repeat--)
+        {
+            piece_stream ps(corpus_, piece);
+            for(std::size_t i = 0; i < N; ++i)
+            {
+                {
+                    request_v1<basic_string_body<alloc_type>,
+                        basic_headers<alloc_type>> m(
+                            std::piecewise_construct,
+                            std::make_tuple(alloc_type(arena)),
+                            std::make_tuple(alloc_type(arena)));
+                    error_code ec;
+                    read(ps, db, m, ec);
+                    if(! BEAST_EXPECTS(! ec, ec.message()))
+                        return;
+                }
+                arena.clear();
+            }
+            BEAST_EXPECT(db.size() == 0);
+        }
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 50;
+
+        for(auto const piece : {1460, 65536})
+        {
+            testcase << "Read speed test, " <<
+                ((Repeat * corpus_.size() + 512) / 1024) << "KB in " <<
+                    (Repeat * N) << " messages, read in pieces of " <<
+                        piece << " bytes";
+
+            timedTest(Trials, "streambuf",
+                [&]
+                {
+                    streambuf sb;
+                    testRead(Repeat, piece, sb);
+                });
+            timedTest(Trials, "streambuf (64KB)",
+                [&]
+                {
+                    streambuf sb(65536);
+                    testRead(Repeat, piece, sb);
+                });
+            timedTest(Trials, "streambuf, monotonic_arena",
+                [&]
+                {
+                    streambuf sb;
+                    testReadArena(Repeat, piece, sb);
+                });
+            timedTest(Trials, "flat_streambuf",
+                [&]
+                {
+                    flat_streambuf sb;
+                    testRead(Repeat, piece, sb);
+                });
+#ifndef _WIN32
+            timedTest(Trials, "circular_streambuf",
+                [&]
+                {
+                    circular_streambuf sb;
+                    testRead(Repeat, piece, sb);
+                });
+#endif
+        }
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(read_bench,http,beast);
+
+} // http
+} // beast
@@ -7,3 +7,47 @@
 
 // Test that header file is self-contained.
 #include <beast/http/resume_context.hpp>
+
+#include <beast/unit_test/suite.hpp>
+
+namespace beast {
+namespace http {
+
+class resume_context_test : public unit_test::suite
+{
+public:
+    struct op
+    {
+        int n = 0;
+
+        void
+        resume()
+        {
+            ++n;
+        }
+    };
+
+    void run() override
+    {
+        op o;
+        resume_context rc0;
+        BEAST_EXPECT(! rc0);
+        resume_context rc1{o};
+        BEAST_EXPECT(rc1);
+        resume_context rc2{rc1};
+        BEAST_EXPECT(rc1 && rc2);
+        resume_context rc3{std::move(rc1)};
+        BEAST_EXPECT(! rc1 && rc3);
+        rc3();
+        BEAST_EXPECT(o.n == 1);
+        rc0 = std::move(rc3);
+        BEAST_EXPECT(rc0 && ! rc3);
+        rc0();
+        BEAST_EXPECT(o.n == 2);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(resume_context,http,beast);
+
+} // http
+} // beast
@@ -20,8 +20,10 @@
 #include <beast/test/yield_to.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/error.hpp>
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace beast {
 namespace http {
@@ -37,6 +39,7 @@ public:
 
     public:
         std::string str;
+        std::size_t calls = 0;
 
         explicit
         string_write_stream(boost::asio::io_service& ios)
@@ -66,9 +69,10 @@ public:
         write_some(
             ConstBufferSequence const& buffers, error_code& ec)
         {
-            auto const n = buffer_size(buffers);
             using boost::asio::buffer_size;
             using boost::asio::buffer_cast;
+            auto const n = buffer_size(buffers);
+            ++calls;
             str.reserve(str.size() + n);
             for(auto const& buffer : buffers)
                 str.append(buffer_cast<char const*>(buffer),
@@ -115,15 +119,64 @@ public:
             }
 
             template<class Write>
-            boost::tribool
+            bool
             operator()(resume_context&&, error_code&, Write&& write)
             {
-                write(boost::asio::buffer(body_));
+                write(boost::asio::buffer(body_), true);
                 return true;
             }
         };
     };
 
+    // Sends the body one octet per call. When an io_service is
+    // set, the writer suspends after each octet, and is resumed
+    // by a handler posted to the io_service either before or
+    // after the write of the octet is started.
+    struct suspend_body
+    {
+        struct value_type
+        {
+            std::string s;
+            boost::asio::io_service* ios = nullptr;
+            bool early = false;
+        };
+
+        class writer
+        {
+            value_type const& body_;
+            std::size_t n_ = 0;
+
+        public:
+            template<bool isRequest, class Allocator>
+            explicit
+            writer(message<isRequest, suspend_body, Allocator> const& msg)
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code&)
+            {
+            }
+
+            template<class Write>
+            boost::tribool
+            operator()(resume_context&& rc, error_code&, Write&& write)
+            {
+                if(n_ >= body_.s.size())
+                    return true;
+                if(body_.ios && body_.early)
+                    body_.ios->post([rc]{ rc(); });
+                write(boost::asio::buffer(&body_.s[n_++], 1));
+                if(! body_.ios)
+                    return false;
+                if(! body_.early)
+                    body_.ios->post([rc]{ rc(); });
+                return boost::indeterminate;
+            }
+        };
+    };
+
     struct fail_body
     {
         class writer;
@@ -218,6 +271,15 @@ public:
         };
     };
 
+    static_assert(! detail::writer_may_suspend<
+        unsized_body::writer>::value, "");
+    static_assert(! detail::writer_may_suspend<
+        string_body::writer>::value, "");
+    static_assert(detail::writer_may_suspend<
+        fail_body::writer>::value, "");
+    static_assert(detail::writer_may_suspend<
+        suspend_body::writer>::value, "");
+
     template<bool isRequest, class Body, class Headers>
     std::string
     str(message_v1<isRequest, Body, Headers> const& m)
@@ -596,6 +658,298 @@ public:
         }
     }
 
+    void testHeaders()
+    {
+        {
+            message_v1<false, empty_body, headers> m;
+            m.version = 10;
+            m.status = 404;
+            m.reason = "Not Found";
+            m.headers.insert("Server", "test");
+            m.headers.insert("X-Empty", "");
+            m.headers.insert("X-Long", std::string(100, 'x'));
+            string_write_stream ss(ios_);
+            error_code ec;
+            write(ss, m, ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(ss.str ==
+                "HTTP/1.0 404 Not Found\r\n"
+                "Server: test\r\n"
+                "X-Empty: \r\n"
+                "X-Long: " + std::string(100, 'x') + "\r\n"
+                "\r\n"
+            );
+        }
+        {
+            message_v1<true, empty_body, headers> m;
+            m.method = "OPTIONS";
+            m.url = "*";
+            m.version = 11;
+            BEAST_EXPECT(str(m) ==
+                "OPTIONS * HTTP/1.1\r\n"
+                "\r\n"
+            );
+        }
+    }
+
+    void
+    testCoalesce(yield_context do_yield)
+    {
+        auto const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\n"
+            "*****\r\n"
+            "0\r\n\r\n";
+        message_v1<false, unsized_body, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.body = "*****";
+        prepare(m);
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            write(ss, m, ec);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.calls == 1);
+        }
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.calls == 1);
+        }
+        m.body = "";
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            write(ss, m, ec);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str ==
+                    "HTTP/1.1 200 OK\r\n"
+                    "Server: test\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n"
+                    "0\r\n\r\n");
+            BEAST_EXPECT(ss.calls == 1);
+        }
+    }
+
+    void
+    testSuspend(yield_context do_yield)
+    {
+        auto const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "1\r\n*\r\n"
+            "1\r\n*\r\n"
+            "1\r\n*\r\n"
+            "0\r\n\r\n";
+        message_v1<false, suspend_body, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.body.s = "***";
+        m.body.ios = &ios_;
+        prepare(m);
+        for(auto early : {false, true})
+        {
+            // The writer writes, then suspends
+            m.body.early = early;
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == expected);
+        }
+        {
+            // The write fails while the writer is suspended
+            m.body.early = false;
+            test::fail_counter fc(1);
+            test::fail_stream<string_write_stream> fs(fc, ios_);
+            error_code ec;
+            async_write(fs, m, do_yield[ec]);
+            BEAST_EXPECT(ec == test::error::fail_error);
+        }
+    }
+
+    // Per-connection storage for the state of pending operations
+    class handler_memory
+    {
+        static std::size_t constexpr slot_size = 1024;
+        static std::size_t constexpr slots = 4;
+
+        typename std::aligned_storage<slot_size>::type slot_[slots];
+        bool used_[slots] = {};
+
+    public:
+        std::size_t allocations = 0;
+        std::size_t fallbacks = 0;
+        std::size_t outstanding = 0;
+
+        void*
+        allocate(std::size_t size)
+        {
+            ++allocations;
+            ++outstanding;
+            if(size <= slot_size)
+                for(std::size_t i = 0; i < slots; ++i)
+                    if(! used_[i])
+                    {
+                        used_[i] = true;
+                        return &slot_[i];
+                    }
+            ++fallbacks;
+            return ::operator new(size);
+        }
+
+        void
+        deallocate(void* p)
+        {
+            --outstanding;
+            for(std::size_t i = 0; i < slots; ++i)
+                if(p == &slot_[i])
+                {
+                    used_[i] = false;
+                    return;
+                }
+            ::operator delete(p);
+        }
+    };
+
+    // Writes the same message repeatedly, as on a keep-alive connection
+    template<class Stream, bool isRequest, class Body, class Headers>
+    class keep_alive_handler
+    {
+        Stream& s_;
+        message_v1<isRequest, Body, Headers> const& m_;
+        handler_memory& mem_;
+        std::size_t& n_;
+
+    public:
+        keep_alive_handler(Stream& s,
+                message_v1<isRequest, Body, Headers> const& m,
+                    handler_memory& mem, std::size_t& n)
+            : s_(s)
+            , m_(m)
+            , mem_(mem)
+            , n_(n)
+        {
+        }
+
+        void
+        operator()(error_code const& ec)
+        {
+            if(! ec && --n_ > 0)
+                async_write(s_, m_, std::move(*this));
+        }
+
+        friend
+        void*
+        asio_handler_allocate(
+            std::size_t size, keep_alive_handler* h)
+        {
+            return h->mem_.allocate(size);
+        }
+
+        friend
+        void
+        asio_handler_deallocate(
+            void* p, std::size_t, keep_alive_handler* h)
+        {
+            h->mem_.deallocate(p);
+        }
+    };
+
+    void
+    testAllocations()
+    {
+        std::size_t constexpr count = 100;
+        boost::asio::io_service ios;
+        string_write_stream ss(ios);
+        handler_memory mem;
+        auto const check =
+            [&](std::size_t n)
+            {
+                BEAST_EXPECT(n == 0);
+                BEAST_EXPECT(mem.allocations >= count);
+                BEAST_EXPECT(mem.fallbacks == 0);
+                BEAST_EXPECT(mem.outstanding == 0);
+            };
+        {
+            message_v1<false, string_body, headers> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Server", "test");
+            m.body = "*****";
+            prepare(m);
+            std::size_t n = count;
+            async_write(ss, m, keep_alive_handler<string_write_stream,
+                false, string_body, headers>{ss, m, mem, n});
+            ios.run();
+            check(n);
+        }
+        {
+            // Chunked, so the writer issues more than one write
+            message_v1<false, unsized_body, headers> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Server", "test");
+            m.body = "*****";
+            prepare(m);
+            std::size_t n = count;
+            mem.allocations = 0;
+            ios.reset();
+            async_write(ss, m, keep_alive_handler<string_write_stream,
+                false, unsized_body, headers>{ss, m, mem, n});
+            ios.run();
+            check(n);
+        }
+        {
+            // Suspending and resuming the writer allocates nothing
+            message_v1<false, suspend_body, headers> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Server", "test");
+            m.body.s = "*****";
+            prepare(m);
+            std::size_t n = count;
+            mem.allocations = 0;
+            ios.reset();
+            async_write(ss, m, keep_alive_handler<string_write_stream,
+                false, suspend_body, headers>{ss, m, mem, n});
+            ios.run();
+            check(n);
+            auto const allocations = mem.allocations;
+            m.body.ios = &ios;
+            for(auto early : {false, true})
+            {
+                m.body.early = early;
+                n = count;
+                mem.allocations = 0;
+                ios.reset();
+                async_write(ss, m, keep_alive_handler<string_write_stream,
+                    false, suspend_body, headers>{ss, m, mem, n});
+                ios.run();
+                check(n);
+                BEAST_EXPECT(mem.allocations == allocations);
+            }
+        }
+    }
+
     void testConvert()
     {
         message_v1<true, string_body, headers> m;
@@ -638,7 +992,13 @@ public:
             this, std::placeholders::_1));
         yield_to(std::bind(&write_test::testFailures,
             this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testCoalesce,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testSuspend,
+            this, std::placeholders::_1));
+        testAllocations();
         testOutput();
+        testHeaders();
         testConvert();
         testOstream();
     }
@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class write_bench_test : public beast::unit_test::suite
+{
+public:
+    // Discards output, counting calls to write_some.
+    // Each call corresponds to one system call on a socket.
+    class null_write_stream
+    {
+    public:
+        std::size_t calls = 0;
+        std::size_t bytes = 0;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(
+            ConstBufferSequence const& buffers, error_code&)
+        {
+            auto const n = boost::asio::buffer_size(buffers);
+            ++calls;
+            bytes += n;
+            return n;
+        }
+    };
+
+    // A body of unknown size, sent in `pieces` parts.
+    // If `markLast` is set, the writer tells the
+    // implementation which buffers are the last ones.
+    template<bool markLast>
+    struct chunked_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            value_type const& body_;
+            std::size_t pieces_;
+            std::size_t n_ = 0;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest,
+                    chunked_body, Headers> const& m)
+                : body_(m.body)
+                , pieces_(1)
+            {
+                if(m.headers.exists("X-Pieces"))
+                    pieces_ = std::stoul(
+                        m.headers["X-Pieces"].to_string());
+            }
+
+            void
+            init(error_code&)
+            {
+            }
+
+            template<class Write>
+            bool
+            operator()(resume_context&&, error_code&, Write&& write)
+            {
+                auto const size = body_.size() / pieces_;
+                auto const last = ++n_ == pieces_;
+                auto const b = boost::asio::buffer(
+                    body_.data() + (n_ - 1) * size,
+                        last ? body_.size() - (n_ - 1) * size : size);
+                if(markLast)
+                    write(b, last);
+                else
+                    write(b);
+                return last;
+            }
+        };
+    };
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    // Returns the number of writes per message
+    template<bool markLast>
+    std::size_t
+    testWriter(std::size_t pieces, std::string const& body)
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 100000;
+
+        message_v1<false, chunked_body<markLast>, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.headers.insert("X-Pieces", std::to_string(pieces));
+        m.body = body;
+        prepare(m);
+
+        null_write_stream ns;
+        error_code ec;
+        timedTest(Trials, std::string{markLast ?
+            "last buffers marked" : "last buffers not marked"} +
+                ", " + std::to_string(pieces) + " piece(s)",
+            [&]
+            {
+                for(std::size_t i = 0; i < Repeat && ! ec; ++i)
+                    write(ns, m, ec);
+            });
+        BEAST_EXPECTS(! ec, ec.message());
+        auto const calls = ns.calls / (Trials * Repeat);
+        log << "Writes per message: " << calls << std::endl;
+        return calls;
+    }
+
+    void
+    testSpeed()
+    {
+        std::string const body(100, '*');
+        testcase << "Chunked write speed test";
+        // The headers go out with the first piece. Marking
+        // the last buffers also saves the write of the final
+        // chunk, leaving one write per piece.
+        BEAST_EXPECT(testWriter<true>(1, body) == 1);
+        BEAST_EXPECT(testWriter<false>(1, body) == 2);
+        BEAST_EXPECT(testWriter<true>(4, body) == 4);
+        BEAST_EXPECT(testWriter<false>(4, body) == 5);
+    }
+
+    void run() override
+    {
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(write_bench,http,beast);
+
+} // http
+} // beast
+